@@ -0,0 +1,570 @@
+/*
+ * File:   bench_SQLiteDatabase.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ *
+ * Benchmarks for the SQLiteDatabase operations with a raw sqlite3 C API baseline for each one. Every benchmark runs
+ * on a cars table at each of the requested sizes and prints one result per line as JSON or CSV.
+ *
+ *  CppQLiteBench [--sizes=1000,10000,100000] [--reps=5] [--format=json|csv] [--db=bench.db]
+ */
+
+#include "../../include/SQLiteDatabase.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+
+const char* kMakes[] = {"Ford", "Chevy", "Toyota", "Honda", "Nissan", "Volvo", "Saab", "Fiat"};
+const std::size_t kMakeCount = sizeof(kMakes) / sizeof(kMakes[0]);
+
+// single row inserts commit one transaction each, cap them so large sizes finish
+const int kMaxSingleInserts = 1000;
+const int kPointLookups = 10000;
+const int kOpenCloseIterations = 200;
+
+struct Config {
+    std::vector<int> sizes;
+    int reps;
+    bool csv;
+    std::string filename;
+};
+
+struct Result {
+    std::string benchmark;
+    std::string impl;
+    int rows;
+    long long ops;
+    std::vector<double> nanoseconds;
+};
+
+/** A benchmark body runs once per rep and returns the time it measured, setup outside the timed part is excluded. */
+typedef std::function<std::chrono::nanoseconds()> Body;
+
+class Stopwatch {
+public:
+    Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+    std::chrono::nanoseconds elapsed() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+    }
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+void check(const int rc, sqlite3* db) {
+    if (rc != SQLITE_OK && rc != SQLITE_ROW && rc != SQLITE_DONE) {
+        throw sqlite::SQLiteDatabaseException(std::string("sqlite3 error: ") + sqlite3_errmsg(db));
+    }
+}
+
+// a benchmark that read the wrong rows measured something else, stop rather than print its time
+void checkRows(const std::string& name, const long long actual, const long long expected) {
+    if (actual != expected) {
+        throw std::runtime_error(name + " read " + std::to_string(actual) + " rows, expected " +
+                                 std::to_string(expected));
+    }
+}
+
+void rawExec(sqlite3* db, const char* sql) {
+    check(sqlite3_exec(db, sql, nullptr, nullptr, nullptr), db);
+}
+
+std::vector<sqlite::Value> carRow(std::mt19937& rng) {
+    return std::vector<sqlite::Value>{kMakes[rng() % kMakeCount], static_cast<int>(15 + rng() % 30),
+                                      static_cast<int>(1500 + rng() % 3000)};
+}
+
+const std::vector<std::string> kColumns = {"make", "mpg", "weight"};
+
+void resetTable(const std::string& filename) {
+    sqlite3* db;
+    check(sqlite3_open(filename.c_str(), &db), db);
+    rawExec(db, "DROP TABLE IF EXISTS cars;"
+                "CREATE TABLE cars (id INTEGER PRIMARY KEY, make TEXT, mpg INTEGER, weight INTEGER)");
+    sqlite3_close(db);
+}
+
+/** Fills the cars table with rows using the raw API so every benchmark starts from the same data. */
+void populate(const std::string& filename, const int rows) {
+    resetTable(filename);
+
+    sqlite3* db;
+    check(sqlite3_open(filename.c_str(), &db), db);
+
+    std::mt19937 rng(42);
+    sqlite3_stmt* stmt;
+    check(sqlite3_prepare_v2(db, "INSERT INTO cars (make, mpg, weight) VALUES (?, ?, ?)", -1, &stmt, nullptr), db);
+
+    rawExec(db, "BEGIN");
+    for (auto ii = 0; ii < rows; ii++) {
+        auto row = carRow(rng);
+        for (std::size_t col = 0; col < row.size(); col++) {
+            row[col].bind(stmt, static_cast<int>(col) + 1);
+        }
+        check(sqlite3_step(stmt), db);
+        sqlite3_reset(stmt);
+    }
+    rawExec(db, "COMMIT");
+
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+}
+
+void openRaw(const std::string& filename, sqlite3** db) {
+    check(sqlite3_open_v2(filename.c_str(), db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr), *db);
+    rawExec(*db, "PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL");
+}
+
+sqlite::OpenOptions benchOptions() {
+    sqlite::OpenOptions options;
+    options.journalMode = "WAL";
+    options.synchronous = "NORMAL";
+    return options;
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+void printHeader(const Config& config) {
+    if (config.csv) {
+        std::cout << "benchmark,impl,rows,ops,reps,ns_per_op_min,ns_per_op_median,ops_per_sec" << std::endl;
+    }
+}
+
+void print(const Config& config, const Result& result) {
+    std::vector<double> perOp;
+    for (auto ns : result.nanoseconds) {
+        perOp.push_back(ns / result.ops);
+    }
+
+    auto best = *std::min_element(perOp.begin(), perOp.end());
+    auto mid = median(perOp);
+    auto opsPerSec = mid > 0 ? 1e9 / mid : 0.0;
+
+    std::ostringstream out;
+
+    if (config.csv) {
+        out << result.benchmark << "," << result.impl << "," << result.rows << "," << result.ops << ","
+            << perOp.size() << "," << best << "," << mid << "," << opsPerSec;
+    }
+    else {
+        out << "{\"benchmark\":\"" << result.benchmark << "\",\"impl\":\"" << result.impl << "\",\"rows\":"
+            << result.rows << ",\"ops\":" << result.ops << ",\"reps\":" << perOp.size() << ",\"ns_per_op_min\":"
+            << best << ",\"ns_per_op_median\":" << mid << ",\"ops_per_sec\":" << opsPerSec << "}";
+    }
+
+    std::cout << out.str() << std::endl;
+}
+
+void run(const Config& config, const std::string& benchmark, const std::string& impl, const int rows,
+         const long long ops, const Body& body) {
+    Result result;
+    result.benchmark = benchmark;
+    result.impl = impl;
+    result.rows = rows;
+    result.ops = ops;
+
+    // one untimed warm up so the page cache and statement caches are hot
+    body();
+
+    for (auto rep = 0; rep < config.reps; rep++) {
+        result.nanoseconds.push_back(static_cast<double>(body().count()));
+    }
+
+    print(config, result);
+}
+
+void benchInsertSingle(const Config& config, const int rows) {
+    auto count = std::min(rows, kMaxSingleInserts);
+
+    run(config, "insert_single", "cppqlite", rows, count, [&]() {
+        resetTable(config.filename);
+        sqlite::SQLiteDatabase db;
+        db.open(config.filename, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, benchOptions());
+        std::mt19937 rng(42);
+
+        Stopwatch timer;
+        for (auto ii = 0; ii < count; ii++) {
+            db.insert("cars", kColumns, carRow(rng));
+        }
+        auto elapsed = timer.elapsed();
+
+        db.close();
+        return elapsed;
+    });
+
+    run(config, "insert_single", "sqlite3", rows, count, [&]() {
+        resetTable(config.filename);
+        sqlite3* db;
+        openRaw(config.filename, &db);
+        std::mt19937 rng(42);
+
+        Stopwatch timer;
+        sqlite3_stmt* stmt;
+        check(sqlite3_prepare_v2(db, "INSERT INTO cars(make, mpg, weight) VALUES (?, ?, ?)", -1, &stmt, nullptr), db);
+        for (auto ii = 0; ii < count; ii++) {
+            auto row = carRow(rng);
+            for (std::size_t col = 0; col < row.size(); col++) {
+                row[col].bind(stmt, static_cast<int>(col) + 1);
+            }
+            check(sqlite3_step(stmt), db);
+            sqlite3_reset(stmt);
+        }
+        sqlite3_finalize(stmt);
+        auto elapsed = timer.elapsed();
+
+        sqlite3_close(db);
+        return elapsed;
+    });
+}
+
+void benchInsertBatched(const Config& config, const int rows) {
+    run(config, "insert_batched", "cppqlite", rows, rows, [&]() {
+        resetTable(config.filename);
+        sqlite::SQLiteDatabase db;
+        db.open(config.filename, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, benchOptions());
+        std::mt19937 rng(42);
+        auto remaining = rows;
+
+        Stopwatch timer;
+        db.insertMany("cars", kColumns, [&](std::vector<sqlite::Value>& row) {
+            if (remaining-- == 0) {
+                return false;
+            }
+            row = carRow(rng);
+            return true;
+        });
+        auto elapsed = timer.elapsed();
+
+        db.close();
+        return elapsed;
+    });
+
+    run(config, "insert_batched", "cppqlite_bound", rows, rows, [&]() {
+        resetTable(config.filename);
+        sqlite::SQLiteDatabase db;
+        db.open(config.filename, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, benchOptions());
+        std::mt19937 rng(42);
+
+        Stopwatch timer;
+        {
+            auto insertCar = db.prepareInsert("cars", kColumns);
+            db.beginTransaction(sqlite::SQLiteDatabase::Immediate);
+            for (auto ii = 0; ii < rows; ii++) {
+                auto row = carRow(rng);
+                insertCar.insert(row[0], row[1], row[2]);
+            }
+            db.endTransaction();
+        }
+        auto elapsed = timer.elapsed();
+
+        db.close();
+        return elapsed;
+    });
+
+    run(config, "insert_batched", "sqlite3", rows, rows, [&]() {
+        resetTable(config.filename);
+        sqlite3* db;
+        openRaw(config.filename, &db);
+        std::mt19937 rng(42);
+
+        Stopwatch timer;
+        sqlite3_stmt* stmt;
+        check(sqlite3_prepare_v2(db, "INSERT INTO cars(make, mpg, weight) VALUES (?, ?, ?)", -1, &stmt, nullptr), db);
+        rawExec(db, "BEGIN");
+        for (auto ii = 0; ii < rows; ii++) {
+            auto row = carRow(rng);
+            for (std::size_t col = 0; col < row.size(); col++) {
+                row[col].bind(stmt, static_cast<int>(col) + 1);
+            }
+            check(sqlite3_step(stmt), db);
+            sqlite3_reset(stmt);
+        }
+        rawExec(db, "COMMIT");
+        sqlite3_finalize(stmt);
+        auto elapsed = timer.elapsed();
+
+        sqlite3_close(db);
+        return elapsed;
+    });
+}
+
+void benchPointLookup(const Config& config, const int rows) {
+    const std::string sql = "SELECT make, mpg, weight FROM cars WHERE id = ?";
+
+    run(config, "point_lookup", "cppqlite", rows, kPointLookups, [&]() {
+        sqlite::SQLiteDatabase db;
+        db.open(config.filename, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, benchOptions());
+        std::mt19937 rng(7);
+        auto found = 0;
+
+        Stopwatch timer;
+        for (auto ii = 0; ii < kPointLookups; ii++) {
+            auto c = db.rawQuery(sql, std::vector<sqlite::Value>{static_cast<int>(1 + rng() % rows)});
+            if (c.next()) {
+                found++;
+            }
+        }
+        auto elapsed = timer.elapsed();
+
+        db.close();
+        checkRows("point_lookup", found, kPointLookups);
+        return elapsed;
+    });
+
+    run(config, "point_lookup", "sqlite3", rows, kPointLookups, [&]() {
+        sqlite3* db;
+        openRaw(config.filename, &db);
+        std::mt19937 rng(7);
+        auto found = 0;
+
+        Stopwatch timer;
+        sqlite3_stmt* stmt;
+        check(sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr), db);
+        for (auto ii = 0; ii < kPointLookups; ii++) {
+            sqlite3_bind_int(stmt, 1, static_cast<int>(1 + rng() % rows));
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                found++;
+            }
+            sqlite3_reset(stmt);
+        }
+        sqlite3_finalize(stmt);
+        auto elapsed = timer.elapsed();
+
+        sqlite3_close(db);
+        checkRows("point_lookup", found, kPointLookups);
+        return elapsed;
+    });
+}
+
+void benchFullScan(const Config& config, const int rows) {
+    const std::string sql = "SELECT id, make, mpg, weight FROM cars";
+
+    run(config, "full_scan_cursor", "cppqlite", rows, rows, [&]() {
+        sqlite::SQLiteDatabase db;
+        db.open(config.filename, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, benchOptions());
+
+        Stopwatch timer;
+        auto c = db.query(sql);
+        auto elapsed = timer.elapsed();
+
+        db.close();
+        checkRows("full_scan_cursor", c.getCount(), rows);
+        return elapsed;
+    });
+
+    // baseline copies every column out as the cursor does
+    run(config, "full_scan_cursor", "sqlite3", rows, rows, [&]() {
+        sqlite3* db;
+        openRaw(config.filename, &db);
+        std::vector<sqlite::Value> values;
+        values.reserve(rows * 4);
+
+        Stopwatch timer;
+        sqlite3_stmt* stmt;
+        check(sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr), db);
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            for (auto col = 0; col < 4; col++) {
+                values.push_back(sqlite::Value::fromColumn(stmt, col));
+            }
+        }
+        sqlite3_finalize(stmt);
+        auto elapsed = timer.elapsed();
+
+        sqlite3_close(db);
+        checkRows("full_scan_cursor", static_cast<long long>(values.size() / 4), rows);
+        return elapsed;
+    });
+}
+
+void benchUpdateRemove(const Config& config, const int rows) {
+    // every rep changes the same rows, the timed statement runs inside a transaction that is rolled back afterwards
+    run(config, "update_predicate", "cppqlite", rows, 1, [&]() {
+        sqlite::SQLiteDatabase db;
+        db.open(config.filename, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, benchOptions());
+        db.beginTransaction();
+
+        Stopwatch timer;
+        db.update("cars", {"mpg"}, std::vector<sqlite::Value>{50}, "weight > ?", std::vector<sqlite::Value>{3000});
+        auto elapsed = timer.elapsed();
+
+        db.rollback();
+        db.close();
+        return elapsed;
+    });
+
+    run(config, "update_predicate", "sqlite3", rows, 1, [&]() {
+        sqlite3* db;
+        openRaw(config.filename, &db);
+        rawExec(db, "BEGIN");
+
+        Stopwatch timer;
+        sqlite3_stmt* stmt;
+        check(sqlite3_prepare_v2(db, "UPDATE cars SET mpg = ? WHERE weight > ?", -1, &stmt, nullptr), db);
+        sqlite3_bind_int(stmt, 1, 50);
+        sqlite3_bind_int(stmt, 2, 3000);
+        check(sqlite3_step(stmt), db);
+        sqlite3_finalize(stmt);
+        auto elapsed = timer.elapsed();
+
+        rawExec(db, "ROLLBACK");
+        sqlite3_close(db);
+        return elapsed;
+    });
+
+    run(config, "remove_predicate", "cppqlite", rows, 1, [&]() {
+        sqlite::SQLiteDatabase db;
+        db.open(config.filename, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, benchOptions());
+        db.beginTransaction();
+
+        Stopwatch timer;
+        db.remove("cars", "weight > ?", std::vector<sqlite::Value>{3000});
+        auto elapsed = timer.elapsed();
+
+        db.rollback();
+        db.close();
+        return elapsed;
+    });
+
+    run(config, "remove_predicate", "sqlite3", rows, 1, [&]() {
+        sqlite3* db;
+        openRaw(config.filename, &db);
+        rawExec(db, "BEGIN");
+
+        Stopwatch timer;
+        sqlite3_stmt* stmt;
+        check(sqlite3_prepare_v2(db, "DELETE FROM cars WHERE weight > ?", -1, &stmt, nullptr), db);
+        sqlite3_bind_int(stmt, 1, 3000);
+        check(sqlite3_step(stmt), db);
+        sqlite3_finalize(stmt);
+        auto elapsed = timer.elapsed();
+
+        rawExec(db, "ROLLBACK");
+        sqlite3_close(db);
+        return elapsed;
+    });
+}
+
+void benchOpenClose(const Config& config, const int rows) {
+    // open is lazy in sqlite, read the version so the schema is actually loaded
+    run(config, "open_close", "cppqlite", rows, kOpenCloseIterations, [&]() {
+        Stopwatch timer;
+        for (auto ii = 0; ii < kOpenCloseIterations; ii++) {
+            sqlite::SQLiteDatabase db;
+            db.open(config.filename, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+            db.getVersion();
+            db.close();
+        }
+        return timer.elapsed();
+    });
+
+    run(config, "open_close", "sqlite3", rows, kOpenCloseIterations, [&]() {
+        Stopwatch timer;
+        for (auto ii = 0; ii < kOpenCloseIterations; ii++) {
+            sqlite3* db;
+            check(sqlite3_open_v2(config.filename.c_str(), &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr),
+                  db);
+            sqlite3_stmt* stmt;
+            check(sqlite3_prepare_v2(db, "PRAGMA user_version", -1, &stmt, nullptr), db);
+            check(sqlite3_step(stmt), db);
+            sqlite3_finalize(stmt);
+            sqlite3_close(db);
+        }
+        return timer.elapsed();
+    });
+}
+
+Config parseArgs(int argc, char** argv) {
+    Config config;
+    config.reps = 5;
+    config.csv = false;
+    config.filename = "bench.db";
+
+    for (auto ii = 1; ii < argc; ii++) {
+        std::string arg(argv[ii]);
+        auto eq = arg.find('=');
+        auto key = arg.substr(0, eq);
+        auto value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+
+        if (key == "--sizes") {
+            std::istringstream in(value);
+            std::string size;
+            while (std::getline(in, size, ',')) {
+                config.sizes.push_back(std::atoi(size.c_str()));
+            }
+        }
+        else if (key == "--reps") {
+            config.reps = std::max(1, std::atoi(value.c_str()));
+        }
+        else if (key == "--format") {
+            config.csv = value == "csv";
+        }
+        else if (key == "--db") {
+            config.filename = value;
+        }
+        else {
+            std::cerr << "usage: " << argv[0] << " [--sizes=1000,10000,100000] [--reps=5] [--format=json|csv]"
+                      << " [--db=bench.db]" << std::endl;
+            std::exit(1);
+        }
+    }
+
+    if (config.sizes.empty()) {
+        config.sizes = {1000, 10000, 100000};
+    }
+
+    return config;
+}
+
+void removeDatabase(const std::string& filename) {
+    std::remove(filename.c_str());
+    std::remove((filename + "-wal").c_str());
+    std::remove((filename + "-shm").c_str());
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    auto config = parseArgs(argc, argv);
+
+    printHeader(config);
+
+    try {
+        for (auto rows : config.sizes) {
+            removeDatabase(config.filename);
+
+            benchInsertSingle(config, rows);
+            benchInsertBatched(config, rows);
+
+            // the read and change benchmarks share one populated table
+            populate(config.filename, rows);
+
+            benchPointLookup(config, rows);
+            benchFullScan(config, rows);
+            benchUpdateRemove(config, rows);
+            benchOpenClose(config, rows);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        removeDatabase(config.filename);
+        return 1;
+    }
+
+    removeDatabase(config.filename);
+
+    return 0;
+}
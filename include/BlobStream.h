@@ -0,0 +1,104 @@
+/*
+ * File:   BlobStream.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef BLOBSTREAM_H
+#define BLOBSTREAM_H
+
+// STL includes
+#include <string>
+#include <cstddef>
+#include <functional>
+
+// 3rd Party Includes
+#include <sqlite3.h>
+
+#include "CppSQLiteGlobals.h"
+
+namespace sqlite {
+
+/** BlobStream reads and writes a single BLOB cell in chunks through the sqlite3_blob incremental I/O API.
+ *
+ * Only the requested bytes are copied so a multi megabyte value never has to sit in memory at once. The size of a
+ * blob is fixed when the row is written, reserve space with zeroblob(?) in the INSERT or UPDATE and then fill it with
+ * write(). Reads and writes continue from the current position like a file, readAt() and writeAt() take an explicit
+ * offset. reopen() moves the handle to another row of the same column without preparing a new handle. A BlobStream
+ * must be closed before the connection it came from is closed.
+ */
+class CPPSQLITE_API BlobStream {
+    friend class SQLiteDatabase;
+public:
+    /** Chunk size used by readChunks. */
+    static const std::size_t kDefaultChunkSize = 64 * 1024;
+
+    BlobStream(BlobStream&& other);
+    BlobStream& operator=(BlobStream&& other);
+    virtual ~BlobStream();
+
+    /** Size of the blob in bytes. */
+    std::size_t size() const { return ( size_ ); }
+    /** Current read and write position. */
+    std::size_t tell() const { return ( pos_ ); }
+    /** Moves the read and write position, offsets past the end are clamped to size(). */
+    void seek(const std::size_t offset);
+    bool isOpen() const { return ( blob_ != nullptr ); }
+
+    /** Reads up to size bytes from the current position.
+     *
+     * @param buffer [out] destination, must hold at least size bytes
+     * @param size [in] maximum number of bytes to read
+     *
+     * @return std::size_t [out] number of bytes read, 0 at the end of the blob
+     */
+    std::size_t read(char* buffer, const std::size_t size);
+
+    /** Writes size bytes at the current position, the blob can not grow so writing past size() throws.
+     *
+     * @param data [in] bytes to write
+     * @param size [in] number of bytes to write
+     */
+    void write(const char* data, const std::size_t size);
+
+    /** Reads exactly size bytes at offset, throws if the range is outside the blob. */
+    void readAt(char* buffer, const std::size_t size, const std::size_t offset);
+    /** Writes exactly size bytes at offset, throws if the range is outside the blob. */
+    void writeAt(const char* data, const std::size_t size, const std::size_t offset);
+
+    /** Reads the blob from the current position to the end, handing each chunk to sink. Memory use is one chunk.
+     *
+     * @param sink [in] called with each chunk and its size
+     * @param chunkSize [in] bytes per chunk
+     */
+    void readChunks(const std::function<void(const char* data, std::size_t size)>& sink,
+                    const std::size_t chunkSize = kDefaultChunkSize);
+
+    /** Moves the handle to the same column of another row and rewinds to position 0.
+     *
+     * @param rowid [in] rowid of the row to open
+     */
+    void reopen(const long long rowid);
+
+    /** Closes the handle, a write handle reports a failed commit of its changes here. */
+    void close();
+
+private:
+    BlobStream(sqlite3* db, sqlite3_blob* blob);
+
+    BlobStream(const BlobStream&);
+    BlobStream& operator=(const BlobStream&);
+
+    sqlite3* db_;
+    sqlite3_blob* blob_;
+    std::size_t size_;
+    std::size_t pos_;
+
+    void checkRange(const std::size_t size, const std::size_t offset) const;
+    void check(const int rc, const std::string& msg) const;
+};
+
+} /* namespace sqlite */
+
+#endif /* BLOBSTREAM_H */
@@ -0,0 +1,206 @@
+/*
+ * File:   BoundStatement.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef BOUNDSTATEMENT_H
+#define BOUNDSTATEMENT_H
+
+// STL includes
+#include <string>
+#include <cstddef>
+#include <type_traits>
+
+// 3rd Party Includes
+#include <sqlite3.h>
+
+#include "CppSQLiteGlobals.h"
+#include "ByteView.h"
+#include "Cursor.h"
+#include "Value.h"
+
+namespace sqlite {
+
+/** ParameterBinder picks the sqlite3_bind_* call for a C++ type at compile time. Specialize it to bind other types.
+ * Text and blobs are bound with SQLITE_STATIC, the value only has to live until the statement has been stepped.
+ * ByteView binds as text, wrap the bytes in a BlobView to bind a blob.
+ */
+template <typename T>
+struct ParameterBinder;
+
+template <>
+struct ParameterBinder<int> {
+    static int bind(sqlite3_stmt* stmt, const int index, const int value) { return sqlite3_bind_int(stmt, index, value); }
+};
+
+template <>
+struct ParameterBinder<long> {
+    static int bind(sqlite3_stmt* stmt, const int index, const long value) {
+        return sqlite3_bind_int64(stmt, index, value);
+    }
+};
+
+template <>
+struct ParameterBinder<long long> {
+    static int bind(sqlite3_stmt* stmt, const int index, const long long value) {
+        return sqlite3_bind_int64(stmt, index, value);
+    }
+};
+
+template <>
+struct ParameterBinder<bool> {
+    static int bind(sqlite3_stmt* stmt, const int index, const bool value) {
+        return sqlite3_bind_int(stmt, index, value ? 1 : 0);
+    }
+};
+
+template <>
+struct ParameterBinder<double> {
+    static int bind(sqlite3_stmt* stmt, const int index, const double value) {
+        return sqlite3_bind_double(stmt, index, value);
+    }
+};
+
+template <>
+struct ParameterBinder<std::string> {
+    static int bind(sqlite3_stmt* stmt, const int index, const std::string& value) {
+        return sqlite3_bind_text(stmt, index, value.data(), static_cast<int>(value.size()), SQLITE_STATIC);
+    }
+};
+
+template <>
+struct ParameterBinder<const char*> {
+    static int bind(sqlite3_stmt* stmt, const int index, const char* value) {
+        return value == nullptr ? sqlite3_bind_null(stmt, index) : sqlite3_bind_text(stmt, index, value, -1,
+                                                                                     SQLITE_STATIC);
+    }
+};
+
+template <>
+struct ParameterBinder<char*> : ParameterBinder<const char*> {};
+
+template <>
+struct ParameterBinder<ByteView> {
+    static int bind(sqlite3_stmt* stmt, const int index, const ByteView& value) {
+        return sqlite3_bind_text(stmt, index, value.data(), static_cast<int>(value.size()), SQLITE_STATIC);
+    }
+};
+
+template <>
+struct ParameterBinder<BlobView> {
+    static int bind(sqlite3_stmt* stmt, const int index, const BlobView& value) {
+        return sqlite3_bind_blob(stmt, index, value.data(), static_cast<int>(value.size()), SQLITE_STATIC);
+    }
+};
+
+template <>
+struct ParameterBinder<std::nullptr_t> {
+    static int bind(sqlite3_stmt* stmt, const int index, std::nullptr_t) { return sqlite3_bind_null(stmt, index); }
+};
+
+template <>
+struct ParameterBinder<Value> {
+    static int bind(sqlite3_stmt* stmt, const int index, const Value& value) { return value.bind(stmt, index); }
+};
+
+/** BoundStatement is a statement prepared once for a fixed sql shape and run many times, each run only binds the
+ * arguments and steps. Get one from SQLiteDatabase::prepare or the prepareQuery, prepareInsert, prepareUpdate and
+ * prepareRemove builders, eg.
+ *
+ *  auto insertCar = db.prepareInsert("cars", {"make", "mpg", "weight"});
+ *  insertCar.insert("Ford", 27, 2000);
+ *
+ * The arguments fill the ? placeholders in order and their count must match. Each binding is picked at compile time
+ * from the argument type through ParameterBinder. The statement must be destroyed before its connection is closed and
+ * must only be used by one thread at a time.
+ */
+class CPPSQLITE_API BoundStatement {
+public:
+    BoundStatement();
+    BoundStatement(BoundStatement&& other);
+    BoundStatement& operator=(BoundStatement&& other);
+    virtual ~BoundStatement();
+
+    /** Runs the statement.
+     *
+     * @return int [out] number of rows changed
+     */
+    template <typename... Args>
+    int execute(const Args&... args);
+
+    /** Runs an insert statement.
+     *
+     * @return long long [out] rowid of the inserted row
+     */
+    template <typename... Args>
+    long long insert(const Args&... args);
+
+    /** Runs a query.
+     *
+     * @return Cursor [out] Cursor containing the result set from the query, will be empty if no results are found.
+     */
+    template <typename... Args>
+    Cursor query(const Args&... args);
+
+    /** sql the statement was prepared from. */
+    std::string getSql() const;
+    /** Number of ? placeholders. */
+    int getParameterCount() const;
+    bool isValid() const { return stmt_ != nullptr; }
+
+private:
+    friend class SQLiteDatabase;
+
+    explicit BoundStatement(sqlite3_stmt* stmt);
+    BoundStatement(const BoundStatement&);
+    BoundStatement& operator=(const BoundStatement&);
+
+    sqlite3_stmt* stmt_;
+
+    template <typename T>
+    int bindOne(const int index, const T& value) {
+        return ParameterBinder<typename std::decay<T>::type>::bind(stmt_, index, value);
+    }
+
+    template <typename... Args>
+    void bind(const Args&... args);
+
+    void checkBound(const std::size_t count, const int* results);
+    int step();
+    Cursor fetch();
+};
+
+template <typename... Args>
+void BoundStatement::bind(const Args&... args) {
+    auto index = 0;
+
+    // braced initializers run left to right, so the arguments bind in order
+    int results[] = {SQLITE_OK, (stmt_ == nullptr ? SQLITE_MISUSE : bindOne(++index, args))...};
+
+    checkBound(sizeof...(Args), results + 1);
+}
+
+template <typename... Args>
+int BoundStatement::execute(const Args&... args) {
+    bind(args...);
+    return step();
+}
+
+template <typename... Args>
+long long BoundStatement::insert(const Args&... args) {
+    bind(args...);
+    step();
+    return sqlite3_last_insert_rowid(sqlite3_db_handle(stmt_));
+}
+
+template <typename... Args>
+Cursor BoundStatement::query(const Args&... args) {
+    bind(args...);
+    return fetch();
+}
+
+} /* namespace sqlite */
+
+#endif /* BOUNDSTATEMENT_H */
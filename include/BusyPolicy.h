@@ -0,0 +1,118 @@
+/*
+ * File:   BusyPolicy.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef BUSYPOLICY_H
+#define BUSYPOLICY_H
+
+// STL includes
+#include <functional>
+#include <mutex>
+#include <random>
+#include <chrono>
+
+// 3rd Party Includes
+#include <sqlite3.h>
+
+#include "CppSQLiteGlobals.h"
+
+namespace sqlite {
+
+/** BusyPolicy decides how a connection waits when another connection holds the lock it needs.
+ *
+ * A policy is installed with sqlite3_busy_handler by SQLiteDatabase::setBusyPolicy. SQLite calls the handler each
+ * time a lock is busy and returns SQLITE_BUSY once the handler gives up. The handler is not called for SQLITE_LOCKED
+ * or when a deferred transaction can't upgrade to a write lock, begin those transactions IMMEDIATE instead.
+ */
+class CPPSQLITE_API BusyPolicy {
+public:
+    /** Called with the number of times the handler was called for the same lock, returns true to try again. May
+     * sleep before returning. */
+    typedef std::function<bool(int count)> Handler;
+
+    /** Default first backoff delay in milliseconds. */
+    static const int kDefaultInitialDelayMs = 1;
+    /** Default longest backoff delay in milliseconds. */
+    static const int kDefaultMaxDelayMs = 100;
+
+    /** Fails right away with SQLITE_BUSY, the SQLite default. */
+    BusyPolicy();
+
+    /** Retries with the same delay steps as sqlite3_busy_timeout until milliseconds have been spent waiting. */
+    static BusyPolicy timeout(const int milliseconds);
+
+    /** Retries with exponential backoff until maxWaitMs have been spent waiting. Each delay doubles from
+     * initialDelayMs up to maxDelayMs and is jittered to a random value between half and all of it, so connections
+     * that lost the same race don't retry in lock step.
+     *
+     * @param maxWaitMs [in] total time to wait for the lock
+     * @param initialDelayMs [in] first delay
+     * @param maxDelayMs [in] longest delay
+     */
+    static BusyPolicy backoff(const int maxWaitMs, const int initialDelayMs = kDefaultInitialDelayMs,
+                              const int maxDelayMs = kDefaultMaxDelayMs);
+
+    /** Hands every busy lock to handler. */
+    static BusyPolicy custom(const Handler& handler);
+
+private:
+    friend class BusyHandler;
+
+    enum Kind {None, Timeout, Backoff, Custom};
+
+    Kind kind_;
+    int maxWaitMs_;
+    int initialDelayMs_;
+    int maxDelayMs_;
+    Handler handler_;
+};
+
+/** Lock waits of a connection, see SQLiteDatabase::getLockWaitStats. */
+struct CPPSQLITE_API LockWaitStats {
+    /** Number of times a statement found its lock busy. */
+    unsigned long long waits = 0;
+    /** Number of retries the policy allowed. */
+    unsigned long long retries = 0;
+    /** Number of waits the policy gave up on, the statement failed with SQLITE_BUSY. */
+    unsigned long long timeouts = 0;
+    /** Total time spent waiting in nanoseconds. */
+    long long waitTime = 0;
+    /** Longest single wait in nanoseconds. */
+    long long maxWaitTime = 0;
+};
+
+/** BusyHandler runs a BusyPolicy as the busy handler of one connection and counts its lock waits. */
+class CPPSQLITE_API BusyHandler {
+public:
+    explicit BusyHandler(const BusyPolicy& policy);
+    virtual ~BusyHandler();
+
+    /** Installs the handler on the connection, the handler must outlive the installation. */
+    void install(sqlite3* db);
+
+    LockWaitStats stats() const;
+    void resetStats();
+
+private:
+    BusyHandler(const BusyHandler&);
+    BusyHandler& operator=(const BusyHandler&);
+
+    BusyPolicy policy_;
+
+    // time waited for the current lock, only touched from the handler
+    std::chrono::nanoseconds waited_;
+    std::minstd_rand random_;
+
+    LockWaitStats stats_;
+    mutable std::mutex mutex_;
+
+    bool retry(const int count);
+    static int callback(void* context, int count);
+};
+
+} /* namespace sqlite */
+
+#endif /* BUSYPOLICY_H */
@@ -0,0 +1,67 @@
+/*
+ * File:   ByteView.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef BYTEVIEW_H
+#define BYTEVIEW_H
+
+// STL includes
+#include <string>
+#include <cstddef>
+#include <cstring>
+
+#include "CppSQLiteGlobals.h"
+
+namespace sqlite {
+
+/** ByteView is a non owning view of text or blob bytes held by a Cursor.
+ *
+ * It is only valid while the Cursor that returned it is alive and unmodified. Use str() to take a copy.
+ */
+class CPPSQLITE_API ByteView {
+public:
+    ByteView() : data_(nullptr), size_(0) {}
+    ByteView(const char* data, const std::size_t size) : data_(data), size_(size) {}
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+
+    char operator[](const std::size_t index) const { return data_[index]; }
+
+    std::string str() const { return std::string(data_, size_); }
+
+    bool operator==(const ByteView& other) const {
+        return size_ == other.size_ && (size_ == 0 || std::memcmp(data_, other.data_, size_) == 0);
+    }
+    bool operator!=(const ByteView& other) const { return !(*this == other); }
+
+    bool operator==(const std::string& other) const { return *this == ByteView(other.data(), other.size()); }
+    bool operator!=(const std::string& other) const { return !(*this == other); }
+
+private:
+    const char* data_;
+    std::size_t size_;
+};
+
+/** BlobView marks bytes to be bound as a blob, a bare ByteView binds as text, eg.
+ *
+ *  insertImage.insert(name, sqlite::BlobView(png.data(), png.size()));
+ *  insertImage.insert(name, sqlite::BlobView(cursor.getBlob(1)));
+ */
+class CPPSQLITE_API BlobView : public ByteView {
+public:
+    BlobView() {}
+    BlobView(const char* data, const std::size_t size) : ByteView(data, size) {}
+    explicit BlobView(const ByteView& bytes) : ByteView(bytes) {}
+};
+
+} /* namespace sqlite */
+
+#endif /* BYTEVIEW_H */
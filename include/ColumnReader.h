@@ -0,0 +1,103 @@
+/*
+ * File:   ColumnReader.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef COLUMNREADER_H
+#define COLUMNREADER_H
+
+// STL includes
+#include <string>
+#include <tuple>
+#include <cstddef>
+
+// 3rd Party Includes
+#include <sqlite3.h>
+
+#include "CppSQLiteGlobals.h"
+#include "Value.h"
+
+namespace sqlite {
+
+/** ColumnReader picks the sqlite3_column_* call for a C++ type at compile time. Specialize it to read other types. */
+template <typename T>
+struct ColumnReader;
+
+template <>
+struct ColumnReader<int> {
+    static int read(sqlite3_stmt* stmt, const int col) { return sqlite3_column_int(stmt, col); }
+};
+
+template <>
+struct ColumnReader<long> {
+    static long read(sqlite3_stmt* stmt, const int col) { return static_cast<long>(sqlite3_column_int64(stmt, col)); }
+};
+
+template <>
+struct ColumnReader<long long> {
+    static long long read(sqlite3_stmt* stmt, const int col) { return sqlite3_column_int64(stmt, col); }
+};
+
+template <>
+struct ColumnReader<bool> {
+    static bool read(sqlite3_stmt* stmt, const int col) { return sqlite3_column_int64(stmt, col) != 0; }
+};
+
+template <>
+struct ColumnReader<double> {
+    static double read(sqlite3_stmt* stmt, const int col) { return sqlite3_column_double(stmt, col); }
+};
+
+template <>
+struct ColumnReader<std::string> {
+    static std::string read(sqlite3_stmt* stmt, const int col) {
+        auto text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, col));
+        return text == nullptr ? std::string() : std::string(text, sqlite3_column_bytes(stmt, col));
+    }
+};
+
+template <>
+struct ColumnReader<Value> {
+    static Value read(sqlite3_stmt* stmt, const int col) { return Value::fromColumn(stmt, col); }
+};
+
+/** RowMapper maps a result row onto a user type. Specialize it with the column types and a map function, eg.
+ *
+ *  template <> struct RowMapper<Car> {
+ *      typedef std::tuple<std::string, int, int> Columns;
+ *      static Car map(std::string make, int mpg, int weight) { return Car{make, mpg, weight}; }
+ *  };
+ */
+template <typename T>
+struct RowMapper;
+
+namespace detail {
+
+template <std::size_t... Indices>
+struct IndexSequence {};
+
+template <std::size_t N, std::size_t... Indices>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, Indices...> {};
+
+template <std::size_t... Indices>
+struct MakeIndexSequence<0, Indices...> {
+    typedef IndexSequence<Indices...> type;
+};
+
+template <typename... Types, std::size_t... Indices>
+std::tuple<Types...> readTuple(sqlite3_stmt* stmt, IndexSequence<Indices...>) {
+    return std::tuple<Types...>(ColumnReader<Types>::read(stmt, static_cast<int>(Indices))...);
+}
+
+template <typename T, typename... Types, std::size_t... Indices>
+T readMapped(sqlite3_stmt* stmt, std::tuple<Types...>*, IndexSequence<Indices...>) {
+    return RowMapper<T>::map(ColumnReader<Types>::read(stmt, static_cast<int>(Indices))...);
+}
+
+} /* namespace sqlite::detail */
+
+} /* namespace sqlite */
+
+#endif /* COLUMNREADER_H */
@@ -12,54 +12,120 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <memory>
+#include <cstddef>
+
+// 3rd Party Includes
+#include <sqlite3.h>
 
 #include "CppSQLiteGlobals.h"
+#include "Value.h"
+#include "ByteView.h"
 
 
 
 namespace sqlite{
 
-typedef std::vector<std::vector<std::string>> ResultSet;
-
+/** Cursor holds a materialized result set.
+ *
+ * Cells are kept in a flat row major table with one entry per cell. Integers and floats are stored in the table, text
+ * and blob bytes are appended to a single contiguous arena and the table stores their offset, so reading a result set
+ * costs a handful of allocations instead of one per cell. Copies of a cursor share the result set and only keep their
+ * own position, so copying is cheap and a cached result can be handed to many readers.
+ */
 class CPPSQLITE_API Cursor {
     friend class SQLiteDatabase;
+    friend class QueryObserver;
+    friend class BoundStatement;
 public:
     Cursor();
     Cursor(const Cursor& orig);
+    Cursor(Cursor&& orig);
+    Cursor& operator=(const Cursor& orig);
+    Cursor& operator=(Cursor&& orig);
     virtual ~Cursor();
     
     bool hasNext();
     void reset();
     
-    const int getCount() const { return ( count_ ); };
-    const std::vector<std::string>& getColumnsNames() const { return columnNames; }
+    const int getCount() const { return ( table_->count ); };
+    const std::vector<std::string>& getColumnsNames() const { return table_->columnNames; }
     int getColumnIndex(const std::string& columnName) const;
 
-    unsigned char getBlob(const int columnIndex) const;
-    unsigned char getBlob(std::string columnName) const;
+    // Column getters, cells are stored in their native SQLite type so numeric getters do not parse text
+    /** Returns a view of the blob bytes without copying them, embedded NULs included. Text cells return their bytes,
+     * other types an empty view. The view is valid as long as the cursor is. */
+    ByteView getBlob(const int columnIndex) const;
+    ByteView getBlob(std::string columnName) const;
     std::string getString(const int columnIndex) const;
     std::string getString(const std::string columnName) const;
     int getInt(const int columnIndex) const;
     int getInt(std::string columnName) const;
-    int getDouble(const int columnIndex) const;
-    int getDouble(std::string columnName) const;
+    double getDouble(const int columnIndex) const;
+    double getDouble(std::string columnName) const;
     long getLong(const int columnIndex) const;
     long getLong(std::string columnName) const;
 
+    /** Returns true if the cell is SQL NULL, getString returns an empty string for NULL cells. */
+    bool isNull(const int columnIndex) const;
+    bool isNull(std::string columnName) const;
+    /** Returns the SQLite storage class of the cell. */
+    Value::Type getType(const int columnIndex) const;
+    /** Returns a copy of the cell. */
+    Value getValue(const int columnIndex) const;
+    /** Returns a view of text or blob bytes without copying them, empty for other types. The view is valid as long
+     * as the cursor is. */
+    ByteView getStringView(const int columnIndex) const;
+    ByteView getStringView(std::string columnName) const;
+
+    /** Number of text and blob bytes held by the cursor. */
+    std::size_t getByteSize() const { return table_->data.size(); }
+    /** Approximate heap memory held by the result set, shared by all copies of the cursor. */
+    std::size_t getMemoryUsage() const;
+
     // cursor navigation
     bool next();
+    /** Moves to the 0 based row position, returns false and leaves the cursor unchanged if there is no such row. */
+    bool moveToPosition(const int position);
+    int getPosition() const { return ( pos_ ); }
     
 private:
-    std::vector<std::string> columnNames;
-    std::map<std::string, int> columnNamesIndexMap;
-    
-    int count_;
+    // one cell of the result table, offset points into data for text and blob cells
+    struct Cell {
+        union {
+            long long integer;
+            double real;
+            std::size_t offset;
+        };
+        std::size_t size;
+        Value::Type type;
+    };
+
+    // result set shared by copies of the cursor, copied before it is changed if it is shared
+    struct Table {
+        std::vector<std::string> columnNames;
+        std::map<std::string, int> columnNamesIndexMap;
+
+        // row major cell table, row r column c is cells[r * columnNames.size() + c]
+        std::vector<Cell> cells;
+        // text and blob bytes, each value is followed by a NUL so text can be parsed in place
+        std::vector<char> data;
+
+        int count;
+
+        Table() : count(0) {}
+    };
+
+    std::shared_ptr<Table> table_;
     int pos_;
-    
-    ResultSet rs;
-    
-    void addRow(const std::vector<std::string>& resultRow);
-    void addColumnName(const std::vector<std::string> &columnNames);
+
+    void addColumn(const std::string& columnName);
+    void addRow(sqlite3_stmt* stmt);
+    void addRow(const std::vector<Value>& resultRow);
+
+    Table& mutableTable();
+    const Cell& getCell(const int columnIndex) const;
+    void appendBytes(Table& table, Cell& cell, const char* bytes, const std::size_t size);
 
 };
 
@@ -0,0 +1,53 @@
+/*
+ * File:   OpenOptions.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef OPENOPTIONS_H
+#define OPENOPTIONS_H
+
+// STL includes
+#include <string>
+#include <limits>
+
+#include "CppSQLiteGlobals.h"
+
+namespace sqlite {
+
+/** OpenOptions holds the performance settings applied when SQLiteDatabase opens a connection.
+ *
+ * Settings left at their defaults are not applied, so the SQLite compile time defaults stay in effect. All PRAGMAs are
+ * sent in one batch right after the connection opens. page_size and journal_mode change the database file and are
+ * skipped on read only connections. See https://sqlite.org/pragma.html for the accepted values.
+ */
+struct CPPSQLITE_API OpenOptions {
+    /** Marks a numeric setting as not set. */
+    static const long long kNotSet = std::numeric_limits<long long>::min();
+
+    /** PRAGMA journal_mode eg. "WAL", "DELETE", "MEMORY" */
+    std::string journalMode;
+    /** PRAGMA synchronous eg. "OFF", "NORMAL", "FULL", "EXTRA" */
+    std::string synchronous;
+    /** PRAGMA temp_store eg. "DEFAULT", "FILE", "MEMORY" */
+    std::string tempStore;
+
+    /** PRAGMA mmap_size in bytes */
+    long long mmapSize = kNotSet;
+    /** PRAGMA cache_size, positive values are pages and negative values are KiB */
+    long long cacheSize = kNotSet;
+    /** PRAGMA page_size in bytes, only takes effect before the first table is created */
+    long long pageSize = kNotSet;
+    /** sqlite3_busy_timeout in milliseconds */
+    long long busyTimeout = kNotSet;
+
+    /** Interpret the filename as a URI, adds SQLITE_OPEN_URI to the open flags */
+    bool uri = false;
+    /** Open the file as immutable, SQLite skips all locking and change detection. Implies a read only URI open. */
+    bool immutable = false;
+};
+
+} /* namespace sqlite */
+
+#endif /* OPENOPTIONS_H */
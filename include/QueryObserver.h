@@ -0,0 +1,166 @@
+/*
+ * File:   QueryObserver.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef QUERYOBSERVER_H
+#define QUERYOBSERVER_H
+
+// STL includes
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+// 3rd Party Includes
+#include <sqlite3.h>
+
+#include "CppSQLiteGlobals.h"
+#include "Cursor.h"
+#include "Value.h"
+#include "TableChangeTracker.h"
+
+namespace sqlite {
+
+class QueryObserver;
+
+/** Result of an observed query handed to its callback.
+ *
+ * Rows are compared by value, a row that changed shows up as removed from previous and added to result.
+ */
+struct CPPSQLITE_API QueryChange {
+    /** New result of the query. */
+    Cursor result;
+    /** Result handed to the previous callback, empty on the first call. */
+    Cursor previous;
+    /** 0 based positions in result of the rows that are not in previous. */
+    std::vector<int> added;
+    /** 0 based positions in previous of the rows that are not in result. */
+    std::vector<int> removed;
+    /** Set if re-running the query failed, result is then the previous result. */
+    std::string error;
+};
+
+/** QuerySubscription keeps an observed query registered, it is cancelled when the subscription is destroyed. */
+class CPPSQLITE_API QuerySubscription {
+public:
+    QuerySubscription();
+    QuerySubscription(QuerySubscription&& other);
+    QuerySubscription& operator=(QuerySubscription&& other);
+    virtual ~QuerySubscription();
+
+    /** Stops the callbacks. Once it returns the callback is not running and will not be called again, unless cancel
+     * is called from the callback itself. */
+    void cancel();
+    bool isActive() const;
+
+private:
+    friend class QueryObserver;
+
+    QuerySubscription(const std::shared_ptr<QueryObserver>& observer, const int id);
+    QuerySubscription(const QuerySubscription&);
+    QuerySubscription& operator=(const QuerySubscription&);
+
+    std::weak_ptr<QueryObserver> observer_;
+    int id_;
+};
+
+/** QueryObserver re-runs registered queries after committed transactions on the connection wrote to a table they
+ * read, and hands each callback the new result and the rows that changed.
+ *
+ * The commit hook only marks queries dirty and wakes a dispatcher thread. The dispatcher waits the coalesce delay so
+ * the commits arriving in it share one re-run, then runs the dirty queries on the connection while holding the
+ * connection mutex, so the connection must use the default serialized threading mode. If the connection is inside a
+ * transaction the re-run waits for it to end so results never include uncommitted rows. Callbacks are called on the
+ * dispatcher thread one at a time and only when the result changed, they may use the connection but must not close
+ * it. Writes made through other connections are not seen.
+ */
+class CPPSQLITE_API QueryObserver : public std::enable_shared_from_this<QueryObserver> {
+public:
+    typedef std::function<void(const QueryChange& change)> Callback;
+
+    /** Default time in milliseconds to wait for more commits before re-running queries. */
+    static const int kDefaultCoalesceDelayMs = 10;
+
+    /** Listens to the tracker's commits and starts the dispatcher thread. Must be owned by a shared_ptr. */
+    QueryObserver(sqlite3* db, TableChangeTracker& tracker);
+    virtual ~QueryObserver();
+
+    /** Registers a query. The query runs once before returning and the callback is called with the whole result as
+     * added rows, then again on the dispatcher thread whenever the result changes. If the connection is inside a
+     * transaction the first run is left to the dispatcher too and happens once the transaction ends.
+     *
+     * @param sql [in] sql to execute
+     * @param args [in] binding arguments for the ? placeholders in sql
+     * @param callback [in] called with each new result
+     *
+     * @return QuerySubscription [out] handle that keeps the query registered
+     */
+    QuerySubscription subscribe(const std::string& sql, const std::vector<Value>& args, const Callback& callback);
+
+    /** Sets how long the dispatcher waits for more commits before re-running queries. */
+    void setCoalesceDelay(const int milliseconds);
+
+    /** Number of registered queries. */
+    std::size_t size() const;
+    /** Number of times a query was re-run. */
+    unsigned long long reruns() const;
+
+    /** Stops the dispatcher thread and finalizes the statements of every query, called before the connection closes.
+     * Must not be called from a callback. */
+    void stop();
+
+private:
+    friend class QuerySubscription;
+
+    struct Query {
+        sqlite3_stmt* stmt;
+        std::vector<Value> args;
+        std::set<std::string> tables;
+        Callback callback;
+        Cursor last;
+        bool dirty;
+        // the callback got a first result
+        bool delivered;
+    };
+
+    QueryObserver(const QueryObserver&);
+    QueryObserver& operator=(const QueryObserver&);
+
+    sqlite3* db_;
+    TableChangeTracker& tracker_;
+    int listener_;
+
+    std::map<int, std::shared_ptr<Query>> queries_;
+    int nextId_;
+    // some query is dirty
+    bool dirty_;
+    bool stopping_;
+    int delayMs_;
+    unsigned long long reruns_;
+
+    // guards the fields above, taken inside the connection mutex by the commit hook
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    // held while callbacks run so cancel can wait for them, recursive so a callback can cancel itself
+    std::recursive_mutex callbackMutex_;
+    std::thread thread_;
+
+    void unsubscribe(const int id);
+    void markDirty(const std::set<std::string>& tables, const bool allTables);
+    void run();
+    bool dispatch();
+    Cursor execute(Query& query, std::string& error);
+    static QueryChange diff(const Cursor& previous, const Cursor& result);
+};
+
+} /* namespace sqlite */
+
+#endif /* QUERYOBSERVER_H */
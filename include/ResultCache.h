@@ -0,0 +1,115 @@
+/*
+ * File:   ResultCache.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+// STL includes
+#include <string>
+#include <vector>
+#include <list>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+
+#include "CppSQLiteGlobals.h"
+#include "Cursor.h"
+#include "Value.h"
+
+namespace sqlite {
+
+/** ResultCache keeps materialized query results keyed by their sql and bound arguments, LRU evicted within a memory
+ * budget.
+ *
+ * Cached cursors are never modified, every reader gets a Cursor that shares the cached result set. Each entry
+ * remembers the tables its query reads and is dropped as soon as a transaction that wrote to one of them commits.
+ */
+class CPPSQLITE_API ResultCache {
+public:
+    /** Default memory budget in bytes. */
+    static const std::size_t kDefaultMaxBytes = 16 * 1024 * 1024;
+
+    explicit ResultCache(const std::size_t maxBytes = kDefaultMaxBytes);
+    virtual ~ResultCache();
+
+    /** Builds the cache key for sql and its arguments, arguments of different types never share a key. */
+    static std::string makeKey(const std::string& sql, const std::vector<Value>& args);
+
+    /** Looks up a result, nullptr on a miss. */
+    std::shared_ptr<const Cursor> get(const std::string& key);
+
+    /** Current invalidation generation, read it before running the query that will be passed to put. */
+    unsigned long long generation() const;
+
+    /** Adds a result. It is dropped instead if an invalidation happened since generation was read, because the
+     * result may already be stale, or if it is larger than the whole budget.
+     *
+     * @param key [in] key from makeKey
+     * @param cursor [in] result to cache
+     * @param tables [in] tables the query reads
+     * @param generation [in] generation() from before the query ran
+     */
+    void put(const std::string& key, const Cursor& cursor, const std::set<std::string>& tables,
+             const unsigned long long generation);
+
+    /** Drops every result that reads one of the tables. */
+    void invalidate(const std::set<std::string>& tables);
+    /** Drops every result. */
+    void clear();
+
+    /** Sets the memory budget, evicting least recently used results to fit. */
+    void setMaxBytes(const std::size_t maxBytes);
+    std::size_t maxBytes() const;
+    /** Memory used by the cached results. */
+    std::size_t bytes() const;
+    std::size_t size() const;
+
+    unsigned long long hits() const;
+    unsigned long long misses() const;
+    /** Number of results dropped by invalidate and clear. */
+    unsigned long long invalidations() const;
+    /** Number of results dropped to stay within the memory budget. */
+    unsigned long long evictions() const;
+
+private:
+    struct Entry {
+        std::string key;
+        std::shared_ptr<const Cursor> cursor;
+        std::set<std::string> tables;
+        std::size_t bytes;
+    };
+    typedef std::list<Entry> EntryList;
+
+    ResultCache(const ResultCache&);
+    ResultCache& operator=(const ResultCache&);
+
+    // most recently used result at the front
+    EntryList lru_;
+    std::unordered_map<std::string, EntryList::iterator> index_;
+    // table name to the keys of the results that read it
+    std::unordered_map<std::string, std::unordered_set<std::string>> tableKeys_;
+
+    std::size_t maxBytes_;
+    std::size_t bytes_;
+    unsigned long long generation_;
+    unsigned long long hits_;
+    unsigned long long misses_;
+    unsigned long long invalidations_;
+    unsigned long long evictions_;
+
+    mutable std::mutex mutex_;
+
+    void erase(EntryList::iterator entry);
+    void evict(const std::size_t maxBytes);
+};
+
+} /* namespace sqlite */
+
+#endif /* RESULTCACHE_H */
@@ -0,0 +1,94 @@
+/*
+ * File:   ResultExporter.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef RESULTEXPORTER_H
+#define RESULTEXPORTER_H
+
+// STL includes
+#include <string>
+#include <vector>
+#include <ostream>
+#include <functional>
+#include <cstddef>
+
+// 3rd Party Includes
+#include <sqlite3.h>
+
+#include "CppSQLiteGlobals.h"
+
+namespace sqlite {
+
+/** ResultExporter formats rows straight out of a stepping statement and writes them to a sink in large blocks.
+ *
+ * Only one block of output is held in memory so an export of any size runs in constant memory. Pass an exporter to
+ * SQLiteDatabase::exportQuery. Formats:
+ *
+ *  Csv        RFC 4180, header row of column names, NULL is an empty field, blobs are hex encoded.
+ *  JsonLines  one JSON object per row keyed by column name, blobs are hex encoded strings.
+ *  Binary     little endian, "CQLB" magic, uint32 column count and uint32 length prefixed column names, then for every
+ *             cell a one byte SQLite type followed by int64 (INTEGER), IEEE double (FLOAT), uint32 length prefixed
+ *             bytes (TEXT, BLOB) or nothing (NULL).
+ *
+ * Sink errors are reported by throwing SQLiteDatabaseException, the destructor flushes whatever is left and ignores
+ * errors, call flush() to see them.
+ */
+class CPPSQLITE_API ResultExporter {
+public:
+    enum Format { Csv, JsonLines, Binary };
+
+    /** Receives each full block of output. */
+    typedef std::function<void(const char* data, std::size_t size)> Sink;
+
+    /** Default size of the output block. */
+    static const std::size_t kDefaultBlockSize = 1024 * 1024;
+
+    /** Writes to a callback. */
+    ResultExporter(const Sink& sink, const Format format, const std::size_t blockSize = kDefaultBlockSize);
+    /** Writes to an open file descriptor, the descriptor is not closed. */
+    ResultExporter(const int fd, const Format format, const std::size_t blockSize = kDefaultBlockSize);
+    /** Writes to a stream, the stream must outlive the exporter. */
+    ResultExporter(std::ostream& stream, const Format format, const std::size_t blockSize = kDefaultBlockSize);
+    virtual ~ResultExporter();
+
+    /** Writes the column names, called once before the first row. */
+    void writeHeader(sqlite3_stmt* stmt);
+    /** Writes the row the statement is positioned on. */
+    void writeRow(sqlite3_stmt* stmt);
+    /** Hands the buffered output to the sink. */
+    void flush();
+
+    Format getFormat() const { return format_; }
+    /** Bytes handed to the sink so far. */
+    unsigned long long getBytesWritten() const { return bytesWritten_; }
+
+private:
+    ResultExporter(const ResultExporter&);
+    ResultExporter& operator=(const ResultExporter&);
+
+    Sink sink_;
+    Format format_;
+    std::size_t blockSize_;
+    std::vector<char> buffer_;
+    unsigned long long bytesWritten_;
+
+    // column names pre-escaped as JSON keys
+    std::vector<std::string> jsonKeys_;
+
+    void append(const char* data, const std::size_t size);
+    void append(const std::string& data) { append(data.data(), data.size()); }
+    void append(const char c);
+    void appendUInt32(const unsigned int value);
+    void appendUInt64(const unsigned long long value);
+    void appendHex(const unsigned char* data, const std::size_t size);
+    void appendCsvField(const char* data, const std::size_t size);
+    void appendJsonString(const char* data, const std::size_t size);
+    void appendNumber(sqlite3_stmt* stmt, const int col);
+};
+
+} /* namespace sqlite */
+
+#endif /* RESULTEXPORTER_H */
@@ -0,0 +1,98 @@
+/*
+ * File:   SQLiteAsyncDatabase.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef SQLITEASYNCDATABASE_H
+#define SQLITEASYNCDATABASE_H
+
+// STL includes
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <type_traits>
+
+#include "CppSQLiteGlobals.h"
+#include "SQLiteDatabase.h"
+#include "SQLiteConnectionPool.h"
+
+namespace sqlite {
+
+/** SQLiteAsyncDatabase runs SQLiteDatabase calls on a dedicated executor thread and returns futures for their results.
+ *
+ * Operations run one at a time in the order they were submitted, so a caller can queue an insert followed by a query
+ * and the query sees the insert. Exceptions thrown by an operation are delivered through its future. The destructor
+ * waits for all queued operations to finish.
+ */
+class CPPSQLITE_API SQLiteAsyncDatabase {
+public:
+    /** Runs operations on db, which must stay open until this object is destroyed. */
+    explicit SQLiteAsyncDatabase(SQLiteDatabase& db);
+    /** Runs operations on a pooled connection, the lease is held until this object is destroyed. */
+    explicit SQLiteAsyncDatabase(SQLiteConnectionPool::Lease&& lease);
+    virtual ~SQLiteAsyncDatabase();
+
+    /** Queues any callable taking a SQLiteDatabase& and returns a future for its result. */
+    template <typename Function>
+    std::future<typename std::result_of<Function(SQLiteDatabase&)>::type> submit(Function function);
+
+    /** Queues SQLiteDatabase::query(sql). */
+    std::future<Cursor> queryAsync(const std::string& sql);
+
+    /** Queues SQLiteDatabase::execQuery(sql). */
+    std::future<void> execAsync(const std::string& sql);
+
+    /** Queues the bound parameter SQLiteDatabase::insert, the future holds the rowid of the new row. */
+    std::future<long long> insertAsync(const std::string& table, const std::vector<std::string>& columns,
+                                       const std::vector<Value>& values);
+
+    /** Waits for queued operations to finish and stops the executor thread, later submits throw. */
+    void shutdown();
+
+    /** Number of operations waiting to run. */
+    std::size_t pending() const;
+
+private:
+    SQLiteAsyncDatabase(const SQLiteAsyncDatabase&);
+    SQLiteAsyncDatabase& operator=(const SQLiteAsyncDatabase&);
+
+    std::unique_ptr<SQLiteConnectionPool::Lease> lease_;
+    SQLiteDatabase& db_;
+
+    std::deque<std::function<void()>> queue_;
+    bool stopping_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable queueChanged_;
+
+    std::thread worker_;
+
+    void enqueue(std::function<void()> task);
+    void run();
+};
+
+template <typename Function>
+std::future<typename std::result_of<Function(SQLiteDatabase&)>::type> SQLiteAsyncDatabase::submit(Function function) {
+    typedef typename std::result_of<Function(SQLiteDatabase&)>::type Result;
+
+    // std::function needs a copyable target, packaged_task is move only
+    auto task = std::make_shared<std::packaged_task<Result(SQLiteDatabase&)>>(function);
+    auto result = task->get_future();
+
+    SQLiteDatabase& db = db_;
+    enqueue([task, &db]() { (*task)(db); });
+
+    return result;
+}
+
+} /* namespace sqlite */
+
+#endif /* SQLITEASYNCDATABASE_H */
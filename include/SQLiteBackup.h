@@ -0,0 +1,109 @@
+/*
+ * File:   SQLiteBackup.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef SQLITEBACKUP_H
+#define SQLITEBACKUP_H
+
+// STL includes
+#include <string>
+#include <functional>
+#include <chrono>
+
+// 3rd Party Includes
+#include <sqlite3.h>
+
+#include "CppSQLiteGlobals.h"
+
+namespace sqlite {
+
+class SQLiteDatabase;
+
+/** SQLiteBackup copies a live database into another connection with the sqlite3_backup API.
+ *
+ * The copy is made a few pages at a time. The source is only locked while a step runs, so with a pause between steps
+ * writers on other connections keep going while a backup is taken. If another connection writes to the source the
+ * next step starts over from the first page, getRestarts() counts how often that happened. Writes made through the
+ * source connection itself are copied along without a restart. Both connections must stay open until the backup is
+ * finished or destroyed. Pages copied into the destination bypass its update and commit hooks, so every step that
+ * copies pages empties the destination's result cache and re-runs its observed queries.
+ */
+class CPPSQLITE_API SQLiteBackup {
+public:
+    /** Called after every step with the pages left and the total page count, return false to stop the backup. */
+    typedef std::function<bool(int remaining, int pageCount)> ProgressCallback;
+
+    /** Default number of pages copied per step. */
+    static const int kDefaultPagesPerStep = 256;
+    /** Default pause between steps in milliseconds. */
+    static const int kDefaultPauseMs = 10;
+
+    /** Starts a backup of source into destination, existing contents of destination are replaced.
+     *
+     * @param destination [in] connection written to
+     * @param source [in] connection read from
+     * @param destinationName [in] schema name in destination, "main" or an attached database
+     * @param sourceName [in] schema name in source
+     */
+    SQLiteBackup(SQLiteDatabase& destination, SQLiteDatabase& source, const std::string& destinationName = "main",
+                 const std::string& sourceName = "main");
+    virtual ~SQLiteBackup();
+
+    /** Copies up to pages pages, -1 copies everything that is left in one step.
+     *
+     * @param pages [in] number of pages to copy
+     *
+     * @return bool [out] true once the backup is complete, false if there is more to copy or a lock was in the way
+     */
+    bool step(const int pages = kDefaultPagesPerStep);
+
+    /** Steps until the backup is complete, sleeping pauseMs between steps and after busy steps.
+     *
+     * @param pagesPerStep [in] number of pages per step, -1 copies everything in one step
+     * @param pauseMs [in] milliseconds to sleep between steps
+     * @param progress [in] optional callback, the backup is finished early when it returns false
+     *
+     * @return bool [out] true if the backup completed, false if progress stopped it
+     */
+    bool run(const int pagesPerStep = kDefaultPagesPerStep, const int pauseMs = kDefaultPauseMs,
+             const ProgressCallback& progress = ProgressCallback());
+
+    /** Releases the backup handle, called by the destructor. */
+    void finish();
+
+    /** Pages left to copy as of the last step. */
+    int getRemaining() const;
+    /** Total pages in the source as of the last step. */
+    int getPageCount() const;
+    /** Times the backup started over because another connection wrote to the source. */
+    unsigned long long getRestarts() const { return restarts_; }
+    bool isDone() const { return done_; }
+
+    /** Copies the database file into connection, eg. to load it into a :memory: database. */
+    static void load(SQLiteDatabase& connection, const std::string& filename, const int pagesPerStep = -1,
+                     const int pauseMs = 0);
+    /** Copies connection into the database file, creating or replacing it. */
+    static void save(SQLiteDatabase& connection, const std::string& filename, const int pagesPerStep = -1,
+                     const int pauseMs = 0);
+
+private:
+    SQLiteBackup(const SQLiteBackup&);
+    SQLiteBackup& operator=(const SQLiteBackup&);
+
+    SQLiteDatabase* destinationDatabase_;
+    sqlite3* destination_;
+    sqlite3_backup* backup_;
+    bool done_;
+    unsigned long long restarts_;
+    // pages copied so far in the current pass, a drop means the backup started over
+    int copied_;
+
+    void contentsReplaced();
+};
+
+} /* namespace sqlite */
+
+#endif /* SQLITEBACKUP_H */
@@ -0,0 +1,116 @@
+/*
+ * File:   SQLiteConnectionPool.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef SQLITECONNECTIONPOOL_H
+#define SQLITECONNECTIONPOOL_H
+
+// STL includes
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+#include "CppSQLiteGlobals.h"
+#include "SQLiteDatabase.h"
+
+namespace sqlite {
+
+/** SQLiteConnectionPool manages one writer connection and up to N read only connections to the same database file.
+ *
+ * Every connection is opened with the same OpenOptions, except that the journal mode is always WAL so readers do
+ * not block the writer or each other. Connections are handed out as Lease objects that give the holding thread
+ * exclusive use of the connection and return it to the pool when they go out of scope. The writer is exclusive, so
+ * writes are serialized in the order the writer lease is acquired. Read connections are opened lazily the first time
+ * they are needed. All leases must be released before the pool is destroyed.
+ */
+class CPPSQLITE_API SQLiteConnectionPool {
+public:
+    /** Default number of read only connections. */
+    static const std::size_t kDefaultMaxReadConnections = 4;
+
+    /** Lease gives exclusive use of a pooled connection until it is released or destroyed. */
+    class CPPSQLITE_API Lease {
+        friend class SQLiteConnectionPool;
+    public:
+        Lease(Lease&& other);
+        Lease& operator=(Lease&& other);
+        ~Lease();
+
+        SQLiteDatabase& operator*() const { return *db_; }
+        SQLiteDatabase* operator->() const { return db_; }
+        SQLiteDatabase& get() const { return *db_; }
+
+        bool isWriter() const { return writer_; }
+
+        /** Returns the connection to the pool before the lease is destroyed. */
+        void release();
+
+    private:
+        Lease(SQLiteConnectionPool* pool, SQLiteDatabase* db, const bool writer);
+
+        Lease(const Lease&);
+        Lease& operator=(const Lease&);
+
+        SQLiteConnectionPool* pool_;
+        SQLiteDatabase* db_;
+        bool writer_;
+    };
+
+    SQLiteConnectionPool(const std::string& filename,
+                         const std::size_t maxReadConnections = kDefaultMaxReadConnections,
+                         const OpenOptions& options = OpenOptions());
+    virtual ~SQLiteConnectionPool();
+
+    /** Opens the writer connection, creating the database file if needed, and switches it to WAL mode. */
+    void open();
+
+    /** Closes all idle connections. Connections that are still leased are closed when they are returned. */
+    void close();
+
+    bool isOpen() const;
+
+    /** Waits for an idle read only connection, opening a new one if fewer than maxReadConnections are open. */
+    Lease acquireReader();
+
+    /** Waits for the writer connection. */
+    Lease acquireWriter();
+
+    std::size_t maxReadConnections() const { return maxReadConnections_; }
+
+    /** Number of read only connections currently open. */
+    std::size_t openReadConnections() const;
+
+private:
+    SQLiteConnectionPool(const SQLiteConnectionPool&);
+    SQLiteConnectionPool& operator=(const SQLiteConnectionPool&);
+
+    std::string filename_;
+    std::size_t maxReadConnections_;
+    OpenOptions options_;
+
+    std::unique_ptr<SQLiteDatabase> writer_;
+    bool writerLeased_;
+
+    // every read connection ever opened, idleReaders_ holds the ones not leased
+    std::vector<std::unique_ptr<SQLiteDatabase>> readers_;
+    std::vector<SQLiteDatabase*> idleReaders_;
+    std::size_t openingReaders_;
+
+    bool open_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable readerAvailable_;
+    std::condition_variable writerAvailable_;
+
+    void releaseConnection(SQLiteDatabase* db, const bool writer);
+};
+
+} /* namespace sqlite */
+
+#endif /* SQLITECONNECTIONPOOL_H */
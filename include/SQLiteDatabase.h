@@ -12,6 +12,11 @@
 #include <string>
 #include <exception>
 #include <mutex>
+#include <memory>
+#include <functional>
+#include <tuple>
+#include <vector>
+#include <chrono>
 
 // 3rd Party Includes
 #include <sqlite3.h>
@@ -19,9 +24,29 @@
 // Project includes
 #include "CppSQLiteGlobals.h"
 #include "Cursor.h"
+#include "StreamingCursor.h"
+#include "WindowedCursor.h"
+#include "BlobStream.h"
+#include "ResultExporter.h"
+#include "SQLiteBackup.h"
+#include "TableChangeTracker.h"
+#include "ResultCache.h"
+#include "QueryObserver.h"
+#include "StatementCache.h"
+#include "BoundStatement.h"
+#include "SqlBuilder.h"
+#include "StatementStats.h"
+#include "OpenOptions.h"
+#include "BusyPolicy.h"
+#include "ColumnReader.h"
+#include "SQLiteFunction.h"
+#include "VirtualTable.h"
 
 namespace sqlite {
 
+class Transaction;
+class TransactionStatements;
+
 /** SQLiteDatabaseException custom exception thrown by SQLiteDatabase functions.
  *
  */
@@ -40,7 +65,26 @@ private:
  *
  */
 class CPPSQLITE_API SQLiteDatabase {
+    friend class SQLiteBackup;
+    friend class Transaction;
 public:
+    /** Fills the empty row with the next row to insert, returns false when there are no more rows. */
+    typedef std::function<bool(std::vector<Value>& row)> RowGenerator;
+
+    /** Locking modes of beginTransaction, see https://sqlite.org/lang_transaction.html */
+    enum TransactionMode {
+        /** No lock until the first read or write. Upgrading to a write lock fails right away with SQLITE_BUSY if
+         * another connection wrote since the transaction started reading. */
+        Deferred,
+        /** Takes the write lock up front so the busy policy applies and later writes can't fail to upgrade. */
+        Immediate,
+        /** Takes the write lock up front and keeps readers out too, except in WAL mode where it is Immediate. */
+        Exclusive
+    };
+
+    /** Default number of rows committed per transaction by insertMany. */
+    static const std::size_t kDefaultInsertBatchSize = 10000;
+
     SQLiteDatabase();
     virtual ~SQLiteDatabase();
 
@@ -53,15 +97,30 @@ public:
      */
     void open(const std::string& filename, const int flags);
 
+    /** Opens a connection to the SQLite3 database file and applies the performance options in one batch before
+     * returning, so the connection is tuned before any other statement runs on it.
+     *
+     *  @filename [in] filename filename included path if required pointing to the SQLite3 database file
+     *  @flags [in] flags most common flags are SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE or SQLITE_OPEN_READWRITE
+     *  @options [in] options journal mode, synchronous, cache and mmap sizes, busy timeout and URI flags
+     */
+    void open(const std::string& filename, const int flags, const OpenOptions& options);
+
     /** Closes the connection to the SQLite3 database file. */
     void close();
 
-    /** Beings a database transaction. */
-    void beginTransaction();
+    /** Beings a database transaction. BEGIN, COMMIT and ROLLBACK are prepared once per connection and reused, see
+     * Transaction for a guard that rolls back on scope exit and nests with savepoints.
+     *
+     * @param mode [in] when the transaction takes its locks, writers sharing the file should use Immediate
+     */
+    void beginTransaction(const TransactionMode mode = Deferred);
     /** End the database transaction and commits changes to the database. */
     void endTransaction();
     /** Rollback all database changes from the transaction starting point. */
     void rollback();
+    /** Returns true if the connection is inside a transaction. */
+    bool inTransaction();
 
     /** Gets the database version. This variable is store in the database internal data. */
     int getVersion();
@@ -108,6 +167,82 @@ public:
      */
     Cursor query(const std::string& sql);
 
+    /** Query function that executes the input sql with bound arguments and returns a Cursor of the results.
+     *
+     * @param sql [in] sql to execute
+     * @param selectionArgs [in] binding arguments for the ? placeholders in sql
+     *
+     * @return Cursor [out] Cursor containing the result set from the query, will be empty if not results are found.
+     */
+    Cursor rawQuery(const std::string& sql, const std::vector<Value>& selectionArgs);
+
+    /** Convenience streaming query function, takes the same arguments as query but returns a forward only cursor that
+     * steps the statement on each call to next() instead of reading the whole result set up front.
+     *
+     * @return StreamingCursor [out] forward only cursor positioned before the first row
+     */
+    StreamingCursor queryStreaming(bool distinct, const std::string& table, const std::vector<std::string>& columns,
+                                   const std::string& selection, const std::vector<std::string>& selectionArgs,
+                                   const std::string& groupBy, const std::string& orderBy, const std::string& limit);
+
+    /** Streaming query function that executes the input sql and returns a forward only cursor over the results.
+     *
+     * @param sql [in] sql to execute
+     * @param selectionArgs [in] binding arguments for the ? placeholders in sql
+     *
+     * @return StreamingCursor [out] forward only cursor positioned before the first row
+     */
+    StreamingCursor queryStreaming(const std::string& sql,
+                                   const std::vector<std::string>& selectionArgs = std::vector<std::string>());
+
+    /** Windowed query function, returns a cursor that holds at most windowSize rows in memory and reads the next
+     * window in rowid order as the cursor moves.
+     *
+     * @param table [in] table to query, must have a rowid
+     * @param columns [in] columns to return, all columns if empty
+     * @param selection [in] where column restrictions eg. "field1 = ? AND field2 = ?"
+     * @param selectionArgs [in] where column binding arguments
+     * @param windowSize [in] rows per window
+     *
+     * @return WindowedCursor [out] cursor positioned before the first row
+     */
+    WindowedCursor queryWindowed(const std::string& table, const std::vector<std::string>& columns,
+                                 const std::string& selection, const std::vector<Value>& selectionArgs,
+                                 const std::size_t windowSize = WindowedCursor::kDefaultWindowSize);
+
+    /** Export query function, steps the statement and hands every row to the exporter as it is read, so the result set
+     * is never materialized. The exporter is flushed before returning.
+     *
+     * @param sql [in] sql to execute
+     * @param args [in] binding arguments for the ? placeholders in sql
+     * @param exporter [in] formats the rows and writes them to its sink
+     *
+     * @return long long [out] number of rows exported
+     */
+    long long exportQuery(const std::string& sql, const std::vector<Value>& args, ResultExporter& exporter);
+
+    /** Typed query function, reads every row into a tuple of the given types. The sqlite3_column_* call for each
+     * column is chosen at compile time and the column count is checked once per query, eg.
+     * db.query<long long, double, std::string>("SELECT id, mpg, make FROM cars WHERE weight > ?", {2000})
+     *
+     * @param sql [in] sql to execute
+     * @param args [in] binding arguments for the ? placeholders in sql
+     *
+     * @return std::vector<std::tuple<Types...>> [out] one tuple per row
+     */
+    template <typename... Types>
+    std::vector<std::tuple<Types...>> query(const std::string& sql, const std::vector<Value>& args);
+
+    /** Typed query function that maps every row onto T through its RowMapper<T> specialization.
+     *
+     * @param sql [in] sql to execute
+     * @param args [in] binding arguments for the ? placeholders in sql
+     *
+     * @return std::vector<T> [out] one object per row
+     */
+    template <typename T>
+    std::vector<T> queryAs(const std::string& sql, const std::vector<Value>& args = std::vector<Value>());
+
     /** Convenience insert row into database function
      *
      * @param table [in] table to query
@@ -144,26 +279,344 @@ public:
      */
     int remove(const std::string& table, const std::string& selection, const std::vector<std::string>& selectionArgs);
 
+    /** Bound parameter insert row function. Values are bound to ? placeholders in their native type so the sql text is
+     * the same for every row and the prepared statement is reused from the statement cache.
+     *
+     * @param table [in] table to insert into
+     * @param columns [in] columns to insert
+     * @param values [in] values to bind for each column
+     *
+     * @return long long [out] rowid of the inserted row
+     */
+    long long insert(const std::string& table, const std::vector<std::string>& columns, const std::vector<Value>& values);
+
+    /** Bound parameter update row function.
+     *
+     * @param table [in] table to update
+     * @param columns [in] columns to update
+     * @param values [in] values to bind for each column
+     * @param selection [in] where column restrictions eg. "field1 = ? AND field2 = ?"
+     * @param selectionArgs [in] where column binding arguments, bound after values
+     *
+     * @return int [out] number of records updated
+     */
+    int update(const std::string& table, const std::vector<std::string>& columns, const std::vector<Value>& values,
+               const std::string& selection, const std::vector<Value>& selectionArgs);
+
+    /** Bound parameter delete row function.
+     *
+     * @param table [in] table to delete from
+     * @param selection [in] where column restrictions eg. "field1 = ? AND field2 = ?"
+     * @param selectionArgs [in] where column binding arguments
+     *
+     * @return int [out] number of records deleted
+     */
+    int remove(const std::string& table, const std::string& selection, const std::vector<Value>& selectionArgs);
+
+    /** Bulk insert function. Prepares the insert once, binds and steps every row, and commits every batchSize rows.
+     * If a transaction is already open the rows are inserted inside it and no commits are issued. On error the
+     * current batch is rolled back and earlier batches stay committed.
+     *
+     * @param table [in] table to insert into
+     * @param columns [in] columns to insert
+     * @param rows [in] values for each row, every row must have one value per column
+     * @param batchSize [in] rows per transaction
+     *
+     * @return long long [out] number of rows inserted
+     */
+    long long insertMany(const std::string& table, const std::vector<std::string>& columns,
+                         const std::vector<std::vector<Value>>& rows,
+                         const std::size_t batchSize = kDefaultInsertBatchSize);
+
+    /** Bulk insert function that streams rows from a generator instead of a materialized vector.
+     *
+     * @param table [in] table to insert into
+     * @param columns [in] columns to insert
+     * @param generator [in] called for each row until it returns false
+     * @param batchSize [in] rows per transaction
+     *
+     * @return long long [out] number of rows inserted
+     */
+    long long insertMany(const std::string& table, const std::vector<std::string>& columns,
+                         const RowGenerator& generator, const std::size_t batchSize = kDefaultInsertBatchSize);
+
+    /** Opens a single BLOB cell for incremental reading or writing.
+     *
+     * @param table [in] table holding the blob
+     * @param column [in] blob column
+     * @param rowid [in] rowid of the row
+     * @param writable [in] true to open the blob for writing
+     * @param database [in] schema name, "main" or the name of an attached database
+     *
+     * @return BlobStream [out] handle positioned at the start of the blob
+     */
+    BlobStream openBlob(const std::string& table, const std::string& column, const long long rowid,
+                        const bool writable = false, const std::string& database = "main");
+
     /** Executes the sql and expects no results to be returned. */
     void execQuery(const std::string& sql);
 
+    /** Registers a scalar sql function implemented by a function, lambda or functor. The argument count and the
+     * sqlite3_value_* and sqlite3_result_* calls are picked at compile time from its signature through ArgumentReader
+     * and ResultSetter, eg. db.createFunction("kpl", [](double mpg) { return mpg * 0.425; }, Deterministic).
+     * Exceptions thrown by the function fail the statement with their message. Functions belong to the connection
+     * and are gone once it is closed. Registering a function empties the result cache, and queries calling a function
+     * without Deterministic are never cached.
+     *
+     * @param name [in] sql name of the function, replaces a function with the same name and argument count
+     * @param func [in] callable, copied and kept until the function is replaced or the connection is closed
+     * @param flags [in] FunctionFlags, Deterministic lets the planner use the function in indexes
+     */
+    template <typename Func>
+    void createFunction(const std::string& name, Func func, const int flags = NoFunctionFlags);
+
+    /** Registers an aggregate sql function implemented by a class. A default constructed Aggregate is created per
+     * group, its step member is called for each row with the arguments read as its parameter types and result gives
+     * the value of the group, eg.
+     *
+     *  struct Product {
+     *      double value = 1;
+     *      void step(double x) { value *= x; }
+     *      double result() const { return value; }
+     *  };
+     *  db.createAggregate<Product>("product", Deterministic);
+     */
+    template <typename Aggregate>
+    void createAggregate(const std::string& name, const int flags = NoFunctionFlags);
+
+    /** Registers an aggregate that can also run as a window function. Besides step and result, Aggregate needs an
+     * inverse member taking the same arguments as step that removes a row leaving the window frame. */
+    template <typename Aggregate>
+    void createWindowFunction(const std::string& name, const int flags = NoFunctionFlags);
+
+    /** Exposes rows held in C++ memory as the temporary virtual table temp.name, SQL can then scan and join them
+     * without copying them into the database, see VirtualTable. Like functions the module belongs to the connection.
+     * Queries reading the table bypass the result cache, so changes to the range are seen by the next query.
+     *
+     * @param name [in] table name
+     * @param table [in] columns over the range, must outlive the table or the connection
+     */
+    void createVirtualTable(const std::string& name, VirtualTableBase& table);
+
+    /** Prepares sql once for repeated runs, see BoundStatement.
+     *
+     * @param sql [in] sql with ? placeholders for every value
+     *
+     * @return BoundStatement [out] statement to run with the values to bind, must be destroyed before close
+     */
+    BoundStatement prepare(const std::string& sql);
+
+    /** Prepares the query that query(distinct, ...) would run, the selection arguments are passed on each run. */
+    BoundStatement prepareQuery(bool distinct, const std::string& table, const std::vector<std::string>& columns,
+                                const std::string& selection, const std::string& groupBy = "",
+                                const std::string& orderBy = "", const std::string& limit = "");
+
+    /** Prepares an insert of the columns, the column values are passed on each run. */
+    BoundStatement prepareInsert(const std::string& table, const std::vector<std::string>& columns);
+
+    /** Prepares an update of the columns, the column values and then the selection arguments are passed on each
+     * run. */
+    BoundStatement prepareUpdate(const std::string& table, const std::vector<std::string>& columns,
+                                 const std::string& selection);
+
+    /** Prepares a delete, the selection arguments are passed on each run. */
+    BoundStatement prepareRemove(const std::string& table, const std::string& selection);
+
     /** Executes the sql and expects no results to be returned.
      *
      * @return bool [out] true if the database connection is open
      * */
     bool isOpen();
 
+    /** Sets the maximum number of prepared statements cached by this connection. The convenience functions and
+     * getVersion reuse cached statements instead of parsing the same sql again. 0 disables the cache.
+     *
+     * @param cacheSize [in] maximum number of cached statements, defaults to StatementCache::kDefaultCapacity
+     */
+    void setMaxSqlCacheSize(const std::size_t cacheSize);
+
+    /** Gets the prepared statement cache of this connection, used to read the cache hit and miss counters. */
+    const StatementCache& getStatementCache() const { return *statements_; }
+
+    /** Turns per statement instrumentation on or off. While enabled every statement run on this connection records
+     * its prepare and step time, rows and cache use in a StatementStats grouped by normalized sql. While disabled
+     * the only cost is a null check per statement. Disabling drops the collected numbers.
+     *
+     * @param enabled [in] true to start collecting
+     */
+    void setStatsEnabled(const bool enabled);
+
+    /** Gets the statement stats of this connection, nullptr if instrumentation is disabled. */
+    std::shared_ptr<StatementStats> getStats() const { return stats_; }
+
+    /** Sets the memory budget of the query result cache, 0 disables it and is the default. While enabled query and
+     * rawQuery results of read only statements are cached by sql and arguments, and repeated calls get a Cursor that
+     * shares the cached result set. Only results made of table rows are cached, statements reading no table or a
+     * virtual table, PRAGMAs and calls of functions like random() or date('now') always run. A result is dropped
+     * when a transaction that wrote to one of the tables it reads commits on this connection and the whole cache is
+     * emptied when SQLiteBackup copies pages into it. Writes made through other connections are not seen, and
+     * queries inside an open transaction bypass the cache.
+     *
+     * @param maxBytes [in] memory budget in bytes, eg. ResultCache::kDefaultMaxBytes
+     */
+    void setMaxResultCacheSize(const std::size_t maxBytes);
+
+    /** Gets the query result cache of this connection, nullptr if it is disabled. */
+    std::shared_ptr<ResultCache> getResultCache() const { return results_; }
+
+    /** Sets how statements wait for locks held by other connections, replacing any busy timeout set by
+     * OpenOptions. The policy also counts the lock waits, see getLockWaitStats.
+     *
+     * @param policy [in] eg. BusyPolicy::timeout(1000) or BusyPolicy::backoff(5000)
+     */
+    void setBusyPolicy(const BusyPolicy& policy);
+
+    /** Gets how often and how long this connection waited for locks since the busy policy was set. */
+    LockWaitStats getLockWaitStats() const;
+    void resetLockWaitStats();
+
+    /** Observes a query. The query runs once and the callback gets its result before observe returns, after that
+     * the query is re-run whenever transactions that wrote to one of the tables it reads commit on this connection,
+     * and the callback gets the new result and the rows added and removed. Commits close together share one re-run
+     * and callbacks are skipped if the result did not change. Callbacks run on the observer's dispatcher thread, see
+     * QueryObserver. Observing inside a transaction delivers the first result on the dispatcher thread once the
+     * transaction ends. Writes made through other connections are not seen.
+     *
+     * @param sql [in] sql to execute
+     * @param args [in] binding arguments for the ? placeholders in sql
+     * @param callback [in] called with each new result
+     *
+     * @return QuerySubscription [out] the query is observed until the subscription is cancelled or destroyed
+     */
+    QuerySubscription observe(const std::string& sql, const std::vector<Value>& args,
+                              const QueryObserver::Callback& callback);
+
+    /** Gets the query observer of this connection, created on first use. */
+    std::shared_ptr<QueryObserver> getQueryObserver();
+
 protected:
 
 private:
     sqlite3* db_;
     bool open_;
 
-    std::string getStdString(const unsigned char* text);
+    // shared so copies of this object share the cache along with the connection
+    std::shared_ptr<StatementCache> statements_;
+    // nullptr while instrumentation is disabled
+    std::shared_ptr<StatementStats> stats_;
+    // hooks shared by the features that follow table changes, created on first use
+    std::shared_ptr<TableChangeTracker> changes_;
+    // nullptr while the result cache is disabled
+    std::shared_ptr<ResultCache> results_;
+    int resultListener_;
+    // prepared BEGIN, COMMIT and SAVEPOINT statements, shared like the statement cache
+    std::shared_ptr<TransactionStatements> transactions_;
+    // nullptr until a busy policy is set
+    std::shared_ptr<BusyHandler> busy_;
+    // re-runs observed queries, created on first use
+    std::shared_ptr<QueryObserver> observer_;
+
     std::string getSQLite3ErrorMessage();
 
+    void registerFunction(const std::string& name, const int argumentCount, const int flags, void* userData,
+                          void (*call)(sqlite3_context*, int, sqlite3_value**),
+                          void (*step)(sqlite3_context*, int, sqlite3_value**), void (*final)(sqlite3_context*),
+                          void (*value)(sqlite3_context*), void (*inverse)(sqlite3_context*, int, sqlite3_value**),
+                          void (*destroy)(void*));
+    void execTransaction(const int kind);
+    void savepoint();
+    void releaseSavepoint();
+    void rollbackToSavepoint();
+    void checkColumnCount(sqlite3_stmt* stmt, const int expected);
+    void checkDone(const int rc);
+    void applyOptions(const OpenOptions& options, const bool readOnly);
+    void installTrace();
+    void installHooks();
+    TableChangeTracker& getChangeTracker();
+    Cursor queryCached(const std::string& sql, const std::vector<Value>& args);
+    sqlite3_stmt* prepareCached(const std::string& sql, const std::string& errorMsg);
+    Cursor buildCursor(sqlite3_stmt* stmt);
+    void bindValues(sqlite3_stmt* stmt, const std::vector<Value>& values, const int firstIndex);
+
 };
 
+template <typename... Types>
+std::vector<std::tuple<Types...>> SQLiteDatabase::query(const std::string& sql, const std::vector<Value>& args) {
+    ScopedStatement stmt(*statements_, sql, prepareCached(sql, "Error preparing statment"));
+
+    bindValues(stmt.get(), args, 1);
+    checkColumnCount(stmt.get(), sizeof...(Types));
+
+    std::vector<std::tuple<Types...>> rows;
+    int rc;
+
+    while ((rc = sqlite3_step(stmt.get())) == SQLITE_ROW) {
+        rows.push_back(detail::readTuple<Types...>(stmt.get(),
+                                                   typename detail::MakeIndexSequence<sizeof...(Types)>::type()));
+    }
+
+    checkDone(rc);
+
+    if (stats_) {
+        stats_->recordResult(sqlite3_sql(stmt.get()), rows.size(), 0);
+    }
+
+    return rows;
+}
+
+template <typename Func>
+void SQLiteDatabase::createFunction(const std::string& name, Func func, const int flags) {
+    typedef detail::ScalarFunction<Func> Function;
+
+    registerFunction(name, Function::Traits::arity, flags, new Func(func), &Function::call, nullptr, nullptr, nullptr,
+                     nullptr, &Function::destroy);
+}
+
+template <typename Aggregate>
+void SQLiteDatabase::createAggregate(const std::string& name, const int flags) {
+    typedef detail::AggregateFunction<Aggregate> Function;
+
+    registerFunction(name, Function::StepTraits::arity, flags, nullptr, nullptr, &Function::step, &Function::final,
+                     nullptr, nullptr, nullptr);
+}
+
+template <typename Aggregate>
+void SQLiteDatabase::createWindowFunction(const std::string& name, const int flags) {
+    typedef detail::WindowFunction<Aggregate> Function;
+
+    static_assert(Function::StepTraits::arity == Function::InverseTraits::arity,
+                  "inverse must take the same arguments as step");
+
+    registerFunction(name, Function::StepTraits::arity, flags, nullptr, nullptr, &Function::step, &Function::final,
+                     &Function::value, &Function::inverse, nullptr);
+}
+
+template <typename T>
+std::vector<T> SQLiteDatabase::queryAs(const std::string& sql, const std::vector<Value>& args) {
+    typedef typename RowMapper<T>::Columns Columns;
+
+    ScopedStatement stmt(*statements_, sql, prepareCached(sql, "Error preparing statment"));
+
+    bindValues(stmt.get(), args, 1);
+    checkColumnCount(stmt.get(), std::tuple_size<Columns>::value);
+
+    std::vector<T> rows;
+    int rc;
+
+    while ((rc = sqlite3_step(stmt.get())) == SQLITE_ROW) {
+        rows.push_back(detail::readMapped<T>(stmt.get(), static_cast<Columns*>(nullptr),
+                                             typename detail::MakeIndexSequence<std::tuple_size<Columns>::value>::type()));
+    }
+
+    checkDone(rc);
+
+    if (stats_) {
+        stats_->recordResult(sqlite3_sql(stmt.get()), rows.size(), 0);
+    }
+
+    return rows;
+}
+
 } /* namespace sqlite */
 
 #endif /* SQLITEDATABASE_H_ */
@@ -0,0 +1,388 @@
+/*
+ * File:   SQLiteFunction.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef SQLITEFUNCTION_H
+#define SQLITEFUNCTION_H
+
+// STL includes
+#include <string>
+#include <tuple>
+#include <new>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+// 3rd Party Includes
+#include <sqlite3.h>
+
+#include "CppSQLiteGlobals.h"
+#include "ByteView.h"
+#include "ColumnReader.h"
+#include "Value.h"
+
+#ifndef SQLITE_INNOCUOUS
+#define SQLITE_INNOCUOUS 0
+#endif
+
+#ifndef SQLITE_DIRECTONLY
+#define SQLITE_DIRECTONLY 0
+#endif
+
+namespace sqlite {
+
+/** Flags for SQLiteDatabase::createFunction, createAggregate and createWindowFunction, combine them with |. */
+enum FunctionFlags {
+    /** No flags, SQLite calls the function for every row and it can't be used in indexes. */
+    NoFunctionFlags = 0,
+    /** Same arguments always give the same result, lets the planner factor calls out and use the function in indexes
+     * and CHECK constraints. */
+    Deterministic = SQLITE_DETERMINISTIC,
+    /** No side effects, the function may be used in views and triggers of untrusted schemas. */
+    Innocuous = SQLITE_INNOCUOUS,
+    /** Only usable from top level sql, never from views, triggers or schema structures. */
+    DirectOnly = SQLITE_DIRECTONLY
+};
+
+/** ArgumentReader picks the sqlite3_value_* call for a function parameter type at compile time. Specialize it to take
+ * other types. NULL arguments read as 0 or empty, take a Value to tell them apart.
+ */
+template <typename T>
+struct ArgumentReader;
+
+template <>
+struct ArgumentReader<int> {
+    static int read(sqlite3_value* value) { return sqlite3_value_int(value); }
+};
+
+template <>
+struct ArgumentReader<long> {
+    static long read(sqlite3_value* value) { return static_cast<long>(sqlite3_value_int64(value)); }
+};
+
+template <>
+struct ArgumentReader<long long> {
+    static long long read(sqlite3_value* value) { return sqlite3_value_int64(value); }
+};
+
+template <>
+struct ArgumentReader<bool> {
+    static bool read(sqlite3_value* value) { return sqlite3_value_int64(value) != 0; }
+};
+
+template <>
+struct ArgumentReader<double> {
+    static double read(sqlite3_value* value) { return sqlite3_value_double(value); }
+};
+
+template <>
+struct ArgumentReader<std::string> {
+    static std::string read(sqlite3_value* value) {
+        auto text = reinterpret_cast<const char*>(sqlite3_value_text(value));
+        return text == nullptr ? std::string() : std::string(text, sqlite3_value_bytes(value));
+    }
+};
+
+/** Text or blob bytes without a copy, only valid during the call. */
+template <>
+struct ArgumentReader<ByteView> {
+    static ByteView read(sqlite3_value* value) {
+        auto type = sqlite3_value_type(value);
+        auto data = type == SQLITE_BLOB ? static_cast<const char*>(sqlite3_value_blob(value))
+                                        : reinterpret_cast<const char*>(sqlite3_value_text(value));
+        return data == nullptr ? ByteView() : ByteView(data, sqlite3_value_bytes(value));
+    }
+};
+
+template <>
+struct ArgumentReader<Value> {
+    static Value read(sqlite3_value* value) {
+        switch (sqlite3_value_type(value)) {
+            case SQLITE_INTEGER:
+                return Value(static_cast<long long>(sqlite3_value_int64(value)));
+            case SQLITE_FLOAT:
+                return Value(sqlite3_value_double(value));
+            case SQLITE_TEXT:
+                return Value(ArgumentReader<std::string>::read(value));
+            case SQLITE_BLOB:
+                return Value::blob(sqlite3_value_blob(value), static_cast<std::size_t>(sqlite3_value_bytes(value)));
+            default:
+                return Value();
+        }
+    }
+};
+
+/** ResultSetter picks the sqlite3_result_* call for a function return type at compile time. */
+template <typename T>
+struct ResultSetter;
+
+template <>
+struct ResultSetter<int> {
+    static void set(sqlite3_context* context, const int result) { sqlite3_result_int(context, result); }
+};
+
+template <>
+struct ResultSetter<long> {
+    static void set(sqlite3_context* context, const long result) { sqlite3_result_int64(context, result); }
+};
+
+template <>
+struct ResultSetter<long long> {
+    static void set(sqlite3_context* context, const long long result) { sqlite3_result_int64(context, result); }
+};
+
+template <>
+struct ResultSetter<bool> {
+    static void set(sqlite3_context* context, const bool result) { sqlite3_result_int(context, result ? 1 : 0); }
+};
+
+template <>
+struct ResultSetter<double> {
+    static void set(sqlite3_context* context, const double result) { sqlite3_result_double(context, result); }
+};
+
+template <>
+struct ResultSetter<std::string> {
+    static void set(sqlite3_context* context, const std::string& result) {
+        sqlite3_result_text(context, result.data(), static_cast<int>(result.size()), SQLITE_TRANSIENT);
+    }
+};
+
+template <>
+struct ResultSetter<const char*> {
+    static void set(sqlite3_context* context, const char* result) {
+        if (result == nullptr) {
+            sqlite3_result_null(context);
+        }
+        else {
+            sqlite3_result_text(context, result, -1, SQLITE_TRANSIENT);
+        }
+    }
+};
+
+template <>
+struct ResultSetter<Value> {
+    static void set(sqlite3_context* context, const Value& result) {
+        switch (result.type()) {
+            case Value::Integer:
+                sqlite3_result_int64(context, result.asInt64());
+                break;
+            case Value::Float:
+                sqlite3_result_double(context, result.asDouble());
+                break;
+            case Value::Text:
+                ResultSetter<std::string>::set(context, result.bytes());
+                break;
+            case Value::Blob:
+                sqlite3_result_blob(context, result.bytes().data(), static_cast<int>(result.bytes().size()),
+                                    SQLITE_TRANSIENT);
+                break;
+            default:
+                sqlite3_result_null(context);
+                break;
+        }
+    }
+};
+
+namespace detail {
+
+/** Return and parameter types of a function pointer, member function or callable object. */
+template <typename T>
+struct FunctionTraits : FunctionTraits<decltype(&T::operator())> {};
+
+template <typename R, typename... Args>
+struct FunctionTraits<R(*)(Args...)> {
+    typedef R Result;
+    typedef std::tuple<typename std::decay<Args>::type...> Arguments;
+    static const int arity = sizeof...(Args);
+};
+
+template <typename R, typename... Args>
+struct FunctionTraits<R(Args...)> : FunctionTraits<R(*)(Args...)> {};
+
+template <typename C, typename R, typename... Args>
+struct FunctionTraits<R(C::*)(Args...)> : FunctionTraits<R(*)(Args...)> {};
+
+template <typename C, typename R, typename... Args>
+struct FunctionTraits<R(C::*)(Args...) const> : FunctionTraits<R(*)(Args...)> {};
+
+/** Calls func with the arguments read from argv. */
+template <typename Func, typename... Args, std::size_t... Indices>
+auto invoke(Func& func, sqlite3_value** argv, std::tuple<Args...>*, IndexSequence<Indices...>)
+        -> decltype(func(ArgumentReader<Args>::read(argv[Indices])...)) {
+    return func(ArgumentReader<Args>::read(argv[Indices])...);
+}
+
+template <typename Traits, typename Func>
+auto invoke(Func& func, sqlite3_value** argv)
+        -> decltype(invoke(func, argv, static_cast<typename Traits::Arguments*>(nullptr),
+                           typename MakeIndexSequence<std::tuple_size<typename Traits::Arguments>::value>::type())) {
+    return invoke(func, argv, static_cast<typename Traits::Arguments*>(nullptr),
+                  typename MakeIndexSequence<std::tuple_size<typename Traits::Arguments>::value>::type());
+}
+
+/** Calls func and sets its result, void results are NULL. */
+template <typename R>
+struct Caller {
+    template <typename Traits, typename Func>
+    static void call(sqlite3_context* context, Func& func, sqlite3_value** argv) {
+        ResultSetter<typename std::decay<R>::type>::set(context, invoke<Traits>(func, argv));
+    }
+};
+
+template <>
+struct Caller<void> {
+    template <typename Traits, typename Func>
+    static void call(sqlite3_context* context, Func& func, sqlite3_value** argv) {
+        invoke<Traits>(func, argv);
+        sqlite3_result_null(context);
+    }
+};
+
+/** Exceptions can't cross into SQLite, they become sql errors of the statement. */
+inline void setError(sqlite3_context* context, std::exception_ptr error) {
+    try {
+        std::rethrow_exception(error);
+    }
+    catch (const std::bad_alloc&) {
+        sqlite3_result_error_nomem(context);
+    }
+    catch (const std::exception& e) {
+        sqlite3_result_error(context, e.what(), -1);
+    }
+    catch (...) {
+        sqlite3_result_error(context, "Unknown exception in function", -1);
+    }
+}
+
+/** Calls a member function of object, used for the step, inverse and result members of aggregates. */
+template <typename Object, typename Member>
+struct MemberCall {
+    Object* object;
+    Member member;
+
+    template <typename... Args>
+    auto operator()(Args&&... args) -> decltype((object->*member)(std::forward<Args>(args)...)) {
+        return (object->*member)(std::forward<Args>(args)...);
+    }
+};
+
+/** C entry points for a scalar function object kept as the function's user data. */
+template <typename Func>
+struct ScalarFunction {
+    typedef FunctionTraits<Func> Traits;
+
+    static void call(sqlite3_context* context, int, sqlite3_value** argv) {
+        try {
+            Caller<typename Traits::Result>::template call<Traits>(context,
+                                                                   *static_cast<Func*>(sqlite3_user_data(context)),
+                                                                   argv);
+        }
+        catch (...) {
+            setError(context, std::current_exception());
+        }
+    }
+
+    static void destroy(void* func) { delete static_cast<Func*>(func); }
+};
+
+/** C entry points for an aggregate class. One default constructed instance per group, or per window partition, is
+ * kept in the aggregate context and deleted by final. */
+template <typename Aggregate>
+struct AggregateFunction {
+    typedef decltype(&Aggregate::step) Step;
+    typedef decltype(&Aggregate::result) Result;
+    typedef FunctionTraits<Step> StepTraits;
+    typedef typename FunctionTraits<Result>::Result ResultType;
+
+    static Aggregate* get(sqlite3_context* context, const bool create) {
+        auto slot = static_cast<Aggregate**>(sqlite3_aggregate_context(context, create ? sizeof(Aggregate*) : 0));
+
+        if (slot == nullptr) {
+            return nullptr;
+        }
+        if (*slot == nullptr && create) {
+            *slot = new Aggregate();
+        }
+        return *slot;
+    }
+
+    static void step(sqlite3_context* context, int, sqlite3_value** argv) {
+        try {
+            auto aggregate = get(context, true);
+            if (aggregate == nullptr) {
+                sqlite3_result_error_nomem(context);
+                return;
+            }
+
+            MemberCall<Aggregate, Step> call = {aggregate, &Aggregate::step};
+            invoke<StepTraits>(call, argv);
+        }
+        catch (...) {
+            setError(context, std::current_exception());
+        }
+    }
+
+    static void setResult(sqlite3_context* context, Aggregate& aggregate) {
+        try {
+            ResultSetter<typename std::decay<ResultType>::type>::set(context, aggregate.result());
+        }
+        catch (...) {
+            setError(context, std::current_exception());
+        }
+    }
+
+    static void value(sqlite3_context* context) {
+        auto aggregate = get(context, false);
+
+        if (aggregate == nullptr) {
+            Aggregate empty;
+            setResult(context, empty);
+        }
+        else {
+            setResult(context, *aggregate);
+        }
+    }
+
+    static void final(sqlite3_context* context) {
+        value(context);
+
+        auto slot = static_cast<Aggregate**>(sqlite3_aggregate_context(context, 0));
+        if (slot != nullptr) {
+            delete *slot;
+            *slot = nullptr;
+        }
+    }
+};
+
+/** Adds the inverse entry point of aggregates used as window functions. */
+template <typename Aggregate>
+struct WindowFunction : AggregateFunction<Aggregate> {
+    typedef decltype(&Aggregate::inverse) Inverse;
+    typedef FunctionTraits<Inverse> InverseTraits;
+
+    static void inverse(sqlite3_context* context, int, sqlite3_value** argv) {
+        try {
+            auto aggregate = AggregateFunction<Aggregate>::get(context, true);
+            if (aggregate == nullptr) {
+                sqlite3_result_error_nomem(context);
+                return;
+            }
+
+            MemberCall<Aggregate, Inverse> call = {aggregate, &Aggregate::inverse};
+            invoke<InverseTraits>(call, argv);
+        }
+        catch (...) {
+            setError(context, std::current_exception());
+        }
+    }
+};
+
+} /* namespace sqlite::detail */
+
+} /* namespace sqlite */
+
+#endif /* SQLITEFUNCTION_H */
@@ -10,22 +10,60 @@
 
 #include <string>
 #include <memory>
+#include <map>
+#include <vector>
+#include <utility>
 
 #include "SQLiteDatabase.h"
+#include "SQLiteConnectionPool.h"
 
 namespace sqlite {
 
+/** Time spent opening the database of a SQLiteOpenHelper, see SQLiteOpenHelper::getOpenStats. */
+struct CPPSQLITE_API OpenStats {
+    /** Opening the file and applying the OpenOptions, in nanoseconds. */
+    long long openTime = 0;
+    /** Reading the version and running onCreate, onUpgrade or onDowngrade, in nanoseconds. */
+    long long migrateTime = 0;
+    /** Preparing the registered statements, in nanoseconds. */
+    long long prepareTime = 0;
+    /** Open to first query latency, from the start of the open until the database is returned ready to query, in
+     * nanoseconds. */
+    long long readyTime = 0;
+    /** Whether the open created or changed the schema. */
+    bool migrated = false;
+};
+
 /**
  * SQLiteOpenHelper abstract class for interacting with SQLiteDatabase
  */
 class CPPSQLITE_API SQLiteOpenHelper {
 public:
     SQLiteOpenHelper(const std::string& database_name, const int version);
+    /** Every connection opened by the helper, including the pooled ones, is opened with options. */
+    SQLiteOpenHelper(const std::string& database_name, const int version, const OpenOptions& options);
     virtual ~SQLiteOpenHelper();
 
     SQLiteDatabase& getReadableDatabase();
     SQLiteDatabase& getWriteableDatabase();
 
+    /** Leases one of the pooled read only connections. Unlike getReadableDatabase each thread gets its own
+     * connection, so reads run in parallel. The database is created or upgraded on first use.
+     */
+    SQLiteConnectionPool::Lease acquireReadableDatabase();
+
+    /** Leases the pooled writer connection. Only one writer lease exists at a time so writes are serialized. */
+    SQLiteConnectionPool::Lease acquireWriteableDatabase();
+
+    /** Observes a query on the connection returned by getWriteableDatabase, see SQLiteDatabase::observe. Only writes
+     * made through that connection re-run the query, writes through pooled connections are not seen.
+     */
+    QuerySubscription observe(const std::string& sql, const std::vector<Value>& args,
+                              const QueryObserver::Callback& callback);
+
+    /** Sets the number of pooled read only connections, must be called before the first lease is acquired. */
+    void setMaxReadConnections(const std::size_t maxReadConnections);
+
     virtual void onCreate(SQLiteDatabase& db) = 0;
     virtual void onUpgrade(SQLiteDatabase& db) = 0;
     virtual void onDowngrade(SQLiteDatabase& db) { throw new SQLiteDatabaseException("onDowngrade not implemented"); }
@@ -34,6 +72,29 @@ public:
 
     const std::string& database_name() const { return database_name_; }
 
+    /** Statement registered with registerStatement, prepared when the database was opened. Opens the writeable
+     * database if no database is open. The statement runs on the connection returned by getReadableDatabase or
+     * getWriteableDatabase and must only be used by one thread at a time.
+     *
+     * @param name [in] name given to registerStatement
+     *
+     * @return BoundStatement& [out] statement, valid until the helper is closed
+     */
+    BoundStatement& getStatement(const std::string& name);
+
+    /** Timings of the last open of getReadableDatabase or getWriteableDatabase. */
+    OpenStats getOpenStats() const;
+
+protected:
+    /** Registers sql to prepare each time the database is opened, right after onCreate or onUpgrade so the hot
+     * statements are compiled before the first query. Call it from the subclass constructor. Close the database
+     * through the helper's close when statements are registered, they hold the connection open.
+     *
+     * @param name [in] name to fetch the statement with getStatement
+     * @param sql [in] sql with ? placeholders, see SQLiteDatabase::prepare
+     */
+    void registerStatement(const std::string& name, const std::string& sql);
+
 private:
 
     SQLiteDatabase db_;
@@ -41,10 +102,21 @@ private:
     std::string filename_;
     int version_;
     bool read_only_;
+    OpenOptions options_;
 
     std::mutex db_mutex;
 
+    std::unique_ptr<SQLiteConnectionPool> pool_;
+    std::size_t max_read_connections_;
+
+    std::vector<std::pair<std::string, std::string>> statement_sql_;
+    std::map<std::string, BoundStatement> statements_;
+    OpenStats open_stats_;
+
     SQLiteDatabase& getDatabase(const std::string& filename, const int flags);
+    SQLiteConnectionPool& getConnectionPool();
+    bool prepareDatabase(SQLiteDatabase& db);
+    void prepareStatements();
 };
 
 } /* namespace sqlite */
@@ -0,0 +1,103 @@
+/*
+ * File:   SQLiteWriteQueue.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef SQLITEWRITEQUEUE_H
+#define SQLITEWRITEQUEUE_H
+
+// STL includes
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <chrono>
+
+#include "CppSQLiteGlobals.h"
+#include "SQLiteDatabase.h"
+#include "SQLiteConnectionPool.h"
+
+namespace sqlite {
+
+/** SQLiteWriteQueue coalesces writes from many threads into one transaction per batch.
+ *
+ * Any thread can submit a mutation. A single writer thread takes up to maxBatchSize queued mutations, waiting at most
+ * maxBatchDelay for a batch to fill, and runs them inside one BEGIN IMMEDIATE ... COMMIT so the whole batch costs a
+ * single fsync. Each mutation runs inside its own SAVEPOINT, a mutation that throws is rolled back on its own and the
+ * rest of the batch still commits. Futures complete once the batch has been committed. Mutations must not begin or
+ * end transactions themselves.
+ */
+class CPPSQLITE_API SQLiteWriteQueue {
+public:
+    typedef std::function<void(SQLiteDatabase&)> Mutation;
+
+    /** Default maximum number of mutations per transaction. */
+    static const std::size_t kDefaultMaxBatchSize = 1000;
+
+    /** Writes to db, which must stay open until this object is destroyed. */
+    SQLiteWriteQueue(SQLiteDatabase& db, const std::size_t maxBatchSize = kDefaultMaxBatchSize,
+                     const std::chrono::milliseconds maxBatchDelay = std::chrono::milliseconds(2));
+    /** Writes to a pooled writer connection, the lease is held until this object is destroyed. */
+    SQLiteWriteQueue(SQLiteConnectionPool::Lease&& lease, const std::size_t maxBatchSize = kDefaultMaxBatchSize,
+                     const std::chrono::milliseconds maxBatchDelay = std::chrono::milliseconds(2));
+    virtual ~SQLiteWriteQueue();
+
+    /** Queues a mutation, the future completes when the batch containing it commits. */
+    std::future<void> submit(Mutation mutation);
+
+    /** Queues a bound parameter insert, the future holds the rowid once the batch containing it commits. */
+    std::future<long long> insert(const std::string& table, const std::vector<std::string>& columns,
+                                  const std::vector<Value>& values);
+
+    /** Commits everything already queued and stops the writer thread, later submits throw. */
+    void shutdown();
+
+    /** Number of transactions committed so far. */
+    unsigned long long batchesCommitted() const;
+    /** Number of mutations committed so far. */
+    unsigned long long mutationsCommitted() const;
+
+private:
+    // a queued mutation with the callbacks that complete its future
+    struct Entry {
+        Mutation apply;
+        std::function<void()> commit;
+        std::function<void(std::exception_ptr)> fail;
+    };
+
+    SQLiteWriteQueue(const SQLiteWriteQueue&);
+    SQLiteWriteQueue& operator=(const SQLiteWriteQueue&);
+
+    std::unique_ptr<SQLiteConnectionPool::Lease> lease_;
+    SQLiteDatabase& db_;
+
+    std::size_t maxBatchSize_;
+    std::chrono::milliseconds maxBatchDelay_;
+
+    std::deque<Entry> queue_;
+    bool stopping_;
+
+    unsigned long long batchesCommitted_;
+    unsigned long long mutationsCommitted_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable queueChanged_;
+
+    std::thread worker_;
+
+    void enqueue(Entry entry);
+    void run();
+    void commitBatch(std::vector<Entry>& batch);
+};
+
+} /* namespace sqlite */
+
+#endif /* SQLITEWRITEQUEUE_H */
@@ -0,0 +1,50 @@
+/*
+ * File:   SqlBuilder.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef SQLBUILDER_H
+#define SQLBUILDER_H
+
+// STL includes
+#include <string>
+#include <vector>
+
+#include "CppSQLiteGlobals.h"
+
+namespace sqlite {
+
+/** SqlBuilder writes the sql of the convenience functions for a table, column list and clause shape.
+ *
+ * Each builder sizes the string once and appends into it. Empty clauses are left out. Values are never written into
+ * the sql, every value is a ? placeholder, so the same shape always gives the same sql and can be prepared once with
+ * SQLiteDatabase::prepareQuery, prepareInsert, prepareUpdate or prepareRemove.
+ */
+class CPPSQLITE_API SqlBuilder {
+public:
+    /** SELECT [DISTINCT] columns FROM table [WHERE selection] [GROUP BY groupBy] [ORDER BY orderBy] [LIMIT limit],
+     * all columns if columns is empty. */
+    static std::string select(const bool distinct, const std::string& table, const std::vector<std::string>& columns,
+                              const std::string& selection, const std::string& groupBy, const std::string& orderBy,
+                              const std::string& limit);
+
+    /** INSERT INTO table(columns) VALUES (?, ...) with one placeholder per column. */
+    static std::string insert(const std::string& table, const std::vector<std::string>& columns);
+
+    /** UPDATE table SET column = ?, ... [WHERE selection], the selection placeholders follow the column ones. */
+    static std::string update(const std::string& table, const std::vector<std::string>& columns,
+                              const std::string& selection);
+
+    /** DELETE FROM table [WHERE selection] */
+    static std::string remove(const std::string& table, const std::string& selection);
+
+private:
+    static std::size_t length(const std::vector<std::string>& columns, const std::size_t perColumn);
+    static void appendClause(std::string& sql, const char* keyword, const std::string& clause);
+};
+
+} /* namespace sqlite */
+
+#endif /* SQLBUILDER_H */
@@ -0,0 +1,112 @@
+/*
+ * File:   StatementCache.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef STATEMENTCACHE_H
+#define STATEMENTCACHE_H
+
+// STL includes
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <cstddef>
+
+// 3rd Party Includes
+#include <sqlite3.h>
+
+#include "CppSQLiteGlobals.h"
+
+namespace sqlite {
+
+/** StatementCache keeps a per connection LRU list of prepared statements keyed by their SQL text.
+ *
+ * Statements are checked out of the cache with acquire() and handed back with release(). A checked out statement is
+ * not visible to other callers, so two threads running the same SQL never share a sqlite3_stmt. Released statements
+ * are reset and have their bindings cleared before they can be handed out again.
+ */
+class CPPSQLITE_API StatementCache {
+public:
+    /** Default number of statements kept per connection. */
+    static const std::size_t kDefaultCapacity = 25;
+
+    explicit StatementCache(const std::size_t capacity = kDefaultCapacity);
+    ~StatementCache();
+
+    /** Checks a prepared statement out of the cache, preparing it if it is not cached.
+     *
+     * @param db [in] database connection used to prepare the statement on a cache miss
+     * @param sql [in] sql text, also used as the cache key
+     * @param stmt [out] prepared statement, nullptr on error
+     * @param cacheHit [out] optional, set to true if the statement came from the cache
+     *
+     * @return int [out] SQLITE_OK on success else the sqlite3_prepare_v2 error code
+     */
+    int acquire(sqlite3* db, const std::string& sql, sqlite3_stmt** stmt, bool* cacheHit = nullptr);
+
+    /** Hands a statement back to the cache. The statement is reset and its bindings cleared. If the cache is full the
+     * least recently used statement is finalized.
+     *
+     * @param sql [in] sql text the statement was acquired with
+     * @param stmt [in] statement returned by acquire
+     */
+    void release(const std::string& sql, sqlite3_stmt* stmt);
+
+    /** Finalizes all cached statements. Must be called before the owning connection is closed. */
+    void clear();
+
+    /** Sets the maximum number of cached statements, 0 disables caching. */
+    void setCapacity(const std::size_t capacity);
+    std::size_t capacity() const;
+    std::size_t size() const;
+
+    /** Number of acquire calls served from the cache. */
+    unsigned long long hits() const;
+    /** Number of acquire calls that had to prepare the statement. */
+    unsigned long long misses() const;
+    /** Resets the hit and miss counters. */
+    void resetStats();
+
+private:
+    typedef std::list<std::pair<std::string, sqlite3_stmt*>> StatementList;
+
+    StatementCache(const StatementCache&);
+    StatementCache& operator=(const StatementCache&);
+
+    // most recently used statement at the front
+    StatementList lru_;
+    std::unordered_map<std::string, StatementList::iterator> index_;
+
+    std::size_t capacity_;
+    unsigned long long hits_;
+    unsigned long long misses_;
+
+    mutable std::mutex mutex_;
+
+    void evict(const std::size_t capacity);
+};
+
+/** ScopedStatement returns a statement to its StatementCache when it goes out of scope. */
+class CPPSQLITE_API ScopedStatement {
+public:
+    ScopedStatement(StatementCache& cache, const std::string& sql, sqlite3_stmt* stmt)
+            : cache_(cache), sql_(sql), stmt_(stmt) {}
+    ~ScopedStatement() { if (stmt_ != nullptr) { cache_.release(sql_, stmt_); } }
+
+    sqlite3_stmt* get() const { return stmt_; }
+
+private:
+    ScopedStatement(const ScopedStatement&);
+    ScopedStatement& operator=(const ScopedStatement&);
+
+    StatementCache& cache_;
+    const std::string& sql_;
+    sqlite3_stmt* stmt_;
+};
+
+} /* namespace sqlite */
+
+#endif /* STATEMENTCACHE_H */
@@ -0,0 +1,108 @@
+/*
+ * File:   StatementStats.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef STATEMENTSTATS_H
+#define STATEMENTSTATS_H
+
+// STL includes
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <cstddef>
+
+#include "CppSQLiteGlobals.h"
+
+namespace sqlite {
+
+/** StatementStats collects per statement latency and throughput numbers for a SQLiteDatabase connection.
+ *
+ * Numbers are grouped by normalized sql, where literals are replaced by ? and whitespace is collapsed, so statements
+ * that only differ in their values share an entry. Step times come from the sqlite3_trace_v2 SQLITE_TRACE_PROFILE
+ * event, prepare times, cache hits and materialized rows and bytes from timers in SQLiteDatabase. Latencies are kept
+ * in power of two histograms that cost one increment to update.
+ */
+class CPPSQLITE_API StatementStats {
+public:
+    /** Histogram of nanosecond latencies, bucket i counts values below 2^i ns. */
+    struct CPPSQLITE_API Histogram {
+        static const int kBuckets = 48;
+
+        unsigned long long buckets[kBuckets];
+        unsigned long long count;
+        unsigned long long total;
+        unsigned long long max;
+
+        Histogram();
+
+        void record(const unsigned long long nanoseconds);
+
+        /** Upper bound in ns of the bucket holding the p-th percentile, p in [0, 1]. */
+        unsigned long long percentile(const double p) const;
+        double mean() const;
+    };
+
+    /** Numbers for one normalized statement. */
+    struct CPPSQLITE_API Entry {
+        std::string sql;
+
+        /** Completed executions reported by SQLITE_TRACE_PROFILE. */
+        unsigned long long executions;
+        Histogram prepareTime;
+        Histogram stepTime;
+
+        unsigned long long rowsReturned;
+        unsigned long long rowsChanged;
+        unsigned long long cacheHits;
+        unsigned long long cacheMisses;
+        unsigned long long bytesMaterialized;
+
+        Entry();
+    };
+
+    StatementStats();
+    virtual ~StatementStats();
+
+    /** Records a statement cache lookup and the time it took, including the prepare on a miss. */
+    void recordPrepare(const std::string& sql, const unsigned long long nanoseconds, const bool cacheHit);
+
+    /** Records one completed execution. */
+    void recordExecution(const char* sql, const unsigned long long nanoseconds, const unsigned long long rowsChanged);
+
+    /** Records rows read into a Cursor or typed result and the text and blob bytes they hold. */
+    void recordResult(const char* sql, const unsigned long long rows, const unsigned long long bytes);
+
+    /** Copy of all entries. */
+    std::vector<Entry> snapshot() const;
+
+    /** Clears all entries. */
+    void reset();
+
+    /** Replaces literals with ? and collapses whitespace. */
+    static std::string normalize(const std::string& sql);
+
+private:
+    StatementStats(const StatementStats&);
+    StatementStats& operator=(const StatementStats&);
+
+    // remembered raw sql before the memo is cleared
+    static const std::size_t kMaxRememberedSql = 1024;
+
+    std::vector<Entry> entries_;
+    // raw sql to entry index, saves normalizing the same sql on every call
+    std::unordered_map<std::string, std::size_t> index_;
+    // normalized sql to entry index
+    std::unordered_map<std::string, std::size_t> normalizedIndex_;
+
+    mutable std::mutex mutex_;
+
+    Entry& entry(const std::string& sql);
+};
+
+} /* namespace sqlite */
+
+#endif /* STATEMENTSTATS_H */
@@ -0,0 +1,90 @@
+/*
+ * File:   StreamingCursor.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef STREAMINGCURSOR_H
+#define STREAMINGCURSOR_H
+
+// STL includes
+#include <vector>
+#include <string>
+#include <memory>
+
+// 3rd Party Includes
+#include <sqlite3.h>
+
+#include "CppSQLiteGlobals.h"
+#include "StatementCache.h"
+#include "Value.h"
+
+namespace sqlite {
+
+/** StreamingCursor is a forward only cursor that owns the live statement and steps it on every call to next().
+ *
+ * Rows are read straight out of the statement so memory stays constant no matter how large the result set is and the
+ * first row is available as soon as SQLite produces it. The total row count is not known up front, use Cursor when
+ * getCount() is required. Column getters use the same 1 based column index as Cursor. A StreamingCursor must be
+ * destroyed before the connection it came from is closed.
+ */
+class CPPSQLITE_API StreamingCursor {
+    friend class SQLiteDatabase;
+public:
+    StreamingCursor(StreamingCursor&& other);
+    StreamingCursor& operator=(StreamingCursor&& other);
+    virtual ~StreamingCursor();
+
+    /** Steps the statement to the next row.
+     *
+     * @return bool [out] true if a row is available, false once the result set is exhausted
+     */
+    bool next();
+
+    /** Number of rows stepped so far. */
+    long long getPosition() const { return ( pos_ ); }
+    bool isDone() const { return ( done_ ); }
+
+    const std::vector<std::string>& getColumnsNames() const { return columnNames; }
+    int getColumnIndex(const std::string& columnName) const;
+
+    std::string getString(const int columnIndex) const;
+    std::string getString(const std::string& columnName) const;
+    int getInt(const int columnIndex) const;
+    int getInt(const std::string& columnName) const;
+    double getDouble(const int columnIndex) const;
+    double getDouble(const std::string& columnName) const;
+    long getLong(const int columnIndex) const;
+    long getLong(const std::string& columnName) const;
+
+    /** Returns true if the cell is SQL NULL, getString returns an empty string for NULL cells. */
+    bool isNull(const int columnIndex) const;
+    bool isNull(const std::string& columnName) const;
+    /** Returns the SQLite storage class of the cell. */
+    Value::Type getType(const int columnIndex) const;
+
+    /** Releases the statement before the cursor is destroyed. */
+    void close();
+
+private:
+    StreamingCursor(const std::shared_ptr<StatementCache>& cache, const std::string& sql, sqlite3_stmt* stmt);
+
+    StreamingCursor(const StreamingCursor&);
+    StreamingCursor& operator=(const StreamingCursor&);
+
+    std::shared_ptr<StatementCache> cache_;
+    std::string sql_;
+    sqlite3_stmt* stmt_;
+
+    std::vector<std::string> columnNames;
+
+    long long pos_;
+    bool done_;
+
+    int checkColumnIndex(const int columnIndex) const;
+};
+
+} /* namespace sqlite */
+
+#endif /* STREAMINGCURSOR_H */
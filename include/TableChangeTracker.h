@@ -0,0 +1,120 @@
+/*
+ * File:   TableChangeTracker.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef TABLECHANGETRACKER_H
+#define TABLECHANGETRACKER_H
+
+// STL includes
+#include <string>
+#include <set>
+#include <map>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+
+// 3rd Party Includes
+#include <sqlite3.h>
+
+#include "CppSQLiteGlobals.h"
+
+namespace sqlite {
+
+/** TableChangeTracker reports which tables each committed transaction on a connection wrote to.
+ *
+ * Rows written are collected with sqlite3_update_hook and handed to the listeners from sqlite3_commit_hook, a rollback
+ * drops them. SQLite allows one hook of each kind per connection so every feature that needs table changes shares
+ * the tracker owned by SQLiteDatabase. The tracker also installs an authorizer that turns off the DELETE truncate
+ * optimization, which skips the update hook, and reports statements that drop or alter tables as "all tables
+ * changed". Statements prepared before the tracker was created are not covered, WITHOUT ROWID tables and writes made
+ * through other connections are not seen.
+ */
+class CPPSQLITE_API TableChangeTracker {
+public:
+    /** Called from the commit hook with the tables the transaction wrote, allTables is true if the changes could not
+     * be attributed to tables. The connection must not be used from a listener. */
+    typedef std::function<void(const std::set<std::string>& tables, bool allTables)> Listener;
+
+    /** Installs the hooks on the connection, they are removed by the destructor. */
+    explicit TableChangeTracker(sqlite3* db);
+    virtual ~TableChangeTracker();
+
+    /** Adds a listener, returns an id for removeListener. */
+    int addListener(const Listener& listener);
+    void removeListener(const int id);
+
+    /** Tables the sql reads, found by preparing it once with sqlite3_set_authorizer. Views are resolved to their
+     * tables. Results are remembered per sql. */
+    std::set<std::string> tablesRead(const std::string& sql);
+
+    /** Whether the result of the sql only depends on the rows of the tables it reads, so it stays valid until one of
+     * them changes. False if it reads no table, reads a volatile table, runs a PRAGMA or calls a function whose
+     * result changes between calls, eg. random(), changes() or date('now').
+     */
+    bool isDeterministic(const std::string& sql);
+
+    /** Tells the listeners every table changed, for changes made without the hooks, eg. a backup into the
+     * connection. */
+    void notifyAllChanged();
+
+    /** Marks a table whose rows change without the update hook seeing it, eg. a virtual table over C++ memory.
+     * Queries reading it are never deterministic. */
+    void addVolatileTable(const std::string& table);
+
+    /** Marks a function whose result changes between calls with the same arguments, eg. an application function
+     * registered without the Deterministic flag. Queries calling it are never deterministic. */
+    void addVolatileFunction(const std::string& function);
+
+private:
+    TableChangeTracker(const TableChangeTracker&);
+    TableChangeTracker& operator=(const TableChangeTracker&);
+
+    // remembered tablesRead results before the memo is cleared
+    static const std::size_t kMaxRememberedSql = 1024;
+
+    sqlite3* db_;
+
+    // tables written by the open transaction, only touched from the hooks
+    std::set<std::string> pending_;
+    // a schema change was prepared since the last commit
+    bool schemaChanged_;
+    // table of the DROP being prepared, its DELETE check must not be ignored
+    std::string dropped_;
+    /** What a statement reads, collected by the authorizer. */
+    struct Reads {
+        std::set<std::string> tables;
+        // ran a PRAGMA or called a non-deterministic function
+        bool volatileResult;
+        // called a date or time function, volatile if it may be given 'now'
+        bool hasDateFunction;
+        // lower case names of the functions called
+        std::set<std::string> functions;
+    };
+
+    // set while reads prepares a statement
+    Reads* reads_;
+
+    std::map<int, Listener> listeners_;
+    int nextId_;
+    std::unordered_map<std::string, Reads> tablesRead_;
+    // lower case names
+    std::set<std::string> volatileTables_;
+    std::set<std::string> volatileFunctions_;
+    std::mutex mutex_;
+
+    Reads reads(const std::string& sql);
+    void notify(const std::set<std::string>& tables, const bool allTables);
+
+    static void updateHook(void* context, int op, const char* database, const char* table, sqlite3_int64 rowid);
+    static int commitHook(void* context);
+    static void rollbackHook(void* context);
+    static int authorizer(void* context, int action, const char* arg1, const char* arg2, const char* database,
+                          const char* trigger);
+};
+
+} /* namespace sqlite */
+
+#endif /* TABLECHANGETRACKER_H */
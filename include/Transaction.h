@@ -0,0 +1,86 @@
+/*
+ * File:   Transaction.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef TRANSACTION_H
+#define TRANSACTION_H
+
+// STL includes
+#include <mutex>
+
+// 3rd Party Includes
+#include <sqlite3.h>
+
+#include "CppSQLiteGlobals.h"
+#include "SQLiteDatabase.h"
+
+namespace sqlite {
+
+/** Transaction is a scope guard for a transaction, the transaction is rolled back if the guard goes out of scope
+ * before commit, eg. because an exception unwinds it.
+ *
+ * A guard created while the connection is already inside a transaction opens a SAVEPOINT instead, commit releases it
+ * and rollback only undoes the writes made since it was created, so library code can group its own writes inside a
+ * caller's transaction. Nested guards must end in the reverse order they were created.
+ */
+class CPPSQLITE_API Transaction {
+public:
+    /** Begins a transaction, or a savepoint if the connection is already inside one.
+     *
+     * @param db [in] open connection, must outlive the guard
+     * @param mode [in] locking mode of the transaction, ignored for savepoints
+     */
+    explicit Transaction(SQLiteDatabase& db, const SQLiteDatabase::TransactionMode mode = SQLiteDatabase::Deferred);
+    /** Rolls back if neither commit nor rollback was called. */
+    virtual ~Transaction();
+
+    /** Commits the transaction or releases the savepoint. If the commit fails the guard stays active and rolls back
+     * when it is destroyed. */
+    void commit();
+    /** Rolls back the transaction, or the writes made since the savepoint. */
+    void rollback();
+
+    /** true if the guard opened a savepoint inside another transaction. */
+    bool isNested() const { return nested_; }
+    /** true until commit or rollback is called. */
+    bool isActive() const { return active_; }
+
+private:
+    Transaction(const Transaction&);
+    Transaction& operator=(const Transaction&);
+
+    SQLiteDatabase& db_;
+    bool nested_;
+    bool active_;
+};
+
+/** TransactionStatements holds the transaction control statements of one connection, each is prepared on first use
+ * and then reused so BEGIN, COMMIT and SAVEPOINT are never parsed again. Used by SQLiteDatabase.
+ */
+class CPPSQLITE_API TransactionStatements {
+public:
+    enum Kind {Begin, BeginImmediate, BeginExclusive, Commit, Rollback, Savepoint, Release, RollbackTo, kKindCount};
+
+    TransactionStatements();
+    ~TransactionStatements();
+
+    /** Steps the statement of the given kind, throws SQLiteDatabaseException if it fails. */
+    void exec(sqlite3* db, const Kind kind);
+
+    /** Finalizes the statements. Must be called before the owning connection is closed. */
+    void clear();
+
+private:
+    TransactionStatements(const TransactionStatements&);
+    TransactionStatements& operator=(const TransactionStatements&);
+
+    sqlite3_stmt* statements_[kKindCount];
+    std::mutex mutex_;
+};
+
+} /* namespace sqlite */
+
+#endif /* TRANSACTION_H */
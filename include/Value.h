@@ -0,0 +1,84 @@
+/*
+ * File:   Value.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef VALUE_H
+#define VALUE_H
+
+// STL includes
+#include <string>
+#include <cstddef>
+
+// 3rd Party Includes
+#include <sqlite3.h>
+
+#include "CppSQLiteGlobals.h"
+
+namespace sqlite {
+
+/** Value holds a single SQLite value in its native storage class: integer, float, text, blob or null.
+ *
+ * Integers and floats are stored inline, text and blob bytes are stored in a std::string which may contain embedded
+ * NUL characters.
+ */
+class CPPSQLITE_API Value {
+public:
+    /** SQLite fundamental datatypes, the values match the SQLITE_* type codes */
+    enum Type {
+        Integer = SQLITE_INTEGER,
+        Float = SQLITE_FLOAT,
+        Text = SQLITE_TEXT,
+        Blob = SQLITE_BLOB,
+        Null = SQLITE_NULL
+    };
+
+    Value() : type_(Null), integer_(0) {}
+    Value(const int value) : type_(Integer), integer_(value) {}
+    Value(const long value) : type_(Integer), integer_(value) {}
+    Value(const long long value) : type_(Integer), integer_(value) {}
+    Value(const double value) : type_(Float), float_(value) {}
+    Value(const std::string& value) : type_(Text), integer_(0), bytes_(value) {}
+    Value(const char* value) : type_(value == nullptr ? Null : Text), integer_(0), bytes_(value ? value : "") {}
+
+    /** Creates a blob value from a byte buffer. */
+    static Value blob(const void* data, const std::size_t size);
+
+    /** Reads column col of the current row of stmt in its native type. */
+    static Value fromColumn(sqlite3_stmt* stmt, const int col);
+
+    /** Binds the value to parameter index of stmt with the matching sqlite3_bind_* call.
+     *
+     * @return int [out] result code of the sqlite3_bind_* call
+     */
+    int bind(sqlite3_stmt* stmt, const int index) const;
+
+    Type type() const { return type_; }
+    bool isNull() const { return type_ == Null; }
+
+    /** Integer value, floats are truncated and text is converted the same way SQLite would. Null is 0. */
+    long long asInt64() const;
+    /** Float value, integers are widened and text is converted the same way SQLite would. Null is 0.0. */
+    double asDouble() const;
+    /** Text value, numbers are formatted as text. Null is an empty string. */
+    std::string asString() const;
+
+    /** Raw text or blob bytes, empty for other types. */
+    const std::string& bytes() const { return bytes_; }
+
+private:
+    Type type_;
+
+    union {
+        long long integer_;
+        double float_;
+    };
+
+    std::string bytes_;
+};
+
+} /* namespace sqlite */
+
+#endif /* VALUE_H */
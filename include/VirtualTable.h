@@ -0,0 +1,183 @@
+/*
+ * File:   VirtualTable.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef VIRTUALTABLE_H
+#define VIRTUALTABLE_H
+
+// STL includes
+#include <string>
+#include <vector>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+
+// 3rd Party Includes
+#include <sqlite3.h>
+
+#include "CppSQLiteGlobals.h"
+#include "SQLiteFunction.h"
+#include "Value.h"
+
+namespace sqlite {
+
+/** VirtualTableBase exposes rows held in C++ memory as a read only SQLite virtual table through sqlite3_create_module.
+ * Use the VirtualTable template rather than deriving from it.
+ *
+ * xBestIndex takes equality and range constraints (=, >, >=, <, <=) on every column and on the rowid, the 0 based
+ * position of the row. Rowid constraints and constraints on the column the rows are sorted by, see sortedBy, narrow
+ * the scanned rows with a lookup or binary search. The others are checked in C++ before SQLite reads any column of the
+ * row. SQLite still checks every constraint itself, so rows are never dropped because of type or collation
+ * differences.
+ */
+class CPPSQLITE_API VirtualTableBase {
+public:
+    VirtualTableBase();
+    virtual ~VirtualTableBase();
+
+    /** Declares that the rows are in ascending order of the column, constraints on it then binary search instead of
+     * scanning and ORDER BY it needs no sort.
+     *
+     * @param column [in] name of a column added with column()
+     */
+    void sortedBy(const std::string& column);
+
+    /** Number of rows scanned by the last query, used to check which constraints were pushed down. */
+    std::size_t getRowsScanned() const { return rowsScanned_; }
+
+    /** CREATE TABLE statement declared to SQLite. */
+    std::string getSchema() const;
+
+    /** Module callbacks, shared by every VirtualTable. */
+    static const sqlite3_module* module();
+
+protected:
+    /** Storage class of a column, used to decide when a constraint can narrow the scan. */
+    enum Affinity {AnyAffinity, NumericAffinity, TextAffinity};
+
+    struct Column {
+        std::string name;
+        std::string type;
+        Affinity affinity;
+    };
+
+    std::vector<Column> columns_;
+
+    virtual std::size_t size() const = 0;
+    /** Sets the result of the column of the row, column is the 0 based column index. */
+    virtual void result(const std::size_t row, const int column, sqlite3_context* context) const = 0;
+    /** Reads the column of the row for constraint checks. */
+    virtual Value value(const std::size_t row, const int column) const = 0;
+
+private:
+    friend struct VirtualTableModule;
+
+    VirtualTableBase(const VirtualTableBase&);
+    VirtualTableBase& operator=(const VirtualTableBase&);
+
+    int sortedColumn_;
+    std::size_t rowsScanned_;
+};
+
+/** ColumnAffinity gives the declared sql type of a column accessor result. */
+template <typename T, typename Enable = void>
+struct ColumnAffinity {
+    static const char* type() { return ""; }
+};
+
+template <typename T>
+struct ColumnAffinity<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+    static const char* type() { return "INTEGER"; }
+};
+
+template <typename T>
+struct ColumnAffinity<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+    static const char* type() { return "REAL"; }
+};
+
+template <>
+struct ColumnAffinity<std::string> {
+    static const char* type() { return "TEXT"; }
+};
+
+template <>
+struct ColumnAffinity<const char*> {
+    static const char* type() { return "TEXT"; }
+};
+
+/** VirtualTable exposes a random access range, eg. a std::vector, as a virtual table without copying it. Each column
+ * reads a value out of an element through an accessor, the result is set with ResultSetter so any type it supports
+ * can be returned, eg.
+ *
+ *  sqlite::VirtualTable<std::vector<Car>> table(cars);
+ *  table.column("make", [](const Car& car) { return car.make; });
+ *  table.column("mpg", [](const Car& car) { return car.mpg; });
+ *  db.createVirtualTable("mem_cars", table);
+ *  db.query("SELECT make FROM mem_cars JOIN owners ON owners.make = mem_cars.make WHERE mpg > 30");
+ *
+ * The range and the table object must outlive the virtual table, the range may change between queries but not while
+ * one runs.
+ */
+template <typename Range>
+class VirtualTable : public VirtualTableBase {
+public:
+    typedef typename std::decay<decltype(*std::begin(std::declval<const Range&>()))>::type Element;
+
+    explicit VirtualTable(const Range& range) : range_(range) {}
+
+    /** Adds a column read by accessor, columns must be added before the table is created.
+     *
+     * @param name [in] column name
+     * @param accessor [in] callable taking const Element& and returning a type ResultSetter supports
+     */
+    template <typename Accessor>
+    VirtualTable& column(const std::string& name, Accessor accessor);
+
+protected:
+    std::size_t size() const {
+        return static_cast<std::size_t>(std::distance(std::begin(range_), std::end(range_)));
+    }
+
+    void result(const std::size_t row, const int column, sqlite3_context* context) const {
+        results_[column](*(std::begin(range_) + row), context);
+    }
+
+    Value value(const std::size_t row, const int column) const {
+        return values_[column](*(std::begin(range_) + row));
+    }
+
+private:
+    const Range& range_;
+
+    std::vector<std::function<void(const Element&, sqlite3_context*)>> results_;
+    std::vector<std::function<Value(const Element&)>> values_;
+};
+
+template <typename Range>
+template <typename Accessor>
+VirtualTable<Range>& VirtualTable<Range>::column(const std::string& name, Accessor accessor) {
+    typedef typename std::decay<decltype(accessor(std::declval<const Element&>()))>::type Result;
+
+    Column column;
+    column.name = name;
+    column.type = ColumnAffinity<Result>::type();
+    column.affinity = std::is_arithmetic<Result>::value ? NumericAffinity
+                                                        : (column.type == "TEXT" ? TextAffinity : AnyAffinity);
+    columns_.push_back(column);
+
+    results_.push_back([accessor](const Element& element, sqlite3_context* context) {
+        ResultSetter<Result>::set(context, accessor(element));
+    });
+    values_.push_back([accessor](const Element& element) { return Value(accessor(element)); });
+
+    return *this;
+}
+
+} /* namespace sqlite */
+
+#endif /* VIRTUALTABLE_H */
@@ -0,0 +1,105 @@
+/*
+ * File:   WindowedCursor.h
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef WINDOWEDCURSOR_H
+#define WINDOWEDCURSOR_H
+
+// STL includes
+#include <vector>
+#include <string>
+#include <map>
+#include <cstddef>
+
+#include "CppSQLiteGlobals.h"
+#include "Cursor.h"
+#include "Value.h"
+#include "ByteView.h"
+
+namespace sqlite {
+
+class SQLiteDatabase;
+
+/** WindowedCursor keeps a fixed size window of rows in memory and refills it as the cursor moves, like the Android
+ * CursorWindow.
+ *
+ * Rows are read in rowid order. Moving forward across the window boundary continues from the last rowid of the
+ * previous window, so sequential scans never re-read skipped rows. Jumps to a window that has not been visited use
+ * LIMIT/OFFSET. getCount() runs a COUNT(*) the first time it is called unless the end of the result set has already
+ * been reached. Only tables with a rowid are supported. The database connection must stay open while the cursor is
+ * used. Column getters use the same 1 based column index as Cursor.
+ */
+class CPPSQLITE_API WindowedCursor {
+    friend class SQLiteDatabase;
+public:
+    /** Default number of rows held in memory. */
+    static const std::size_t kDefaultWindowSize = 512;
+
+    virtual ~WindowedCursor();
+
+    bool next();
+    /** Moves to the 0 based row position, returns false and keeps the current row if there is no such row. */
+    bool moveToPosition(const long long position);
+    long long getPosition() const { return ( pos_ ); }
+
+    /** Number of rows in the result set, computed on first use. */
+    long long getCount();
+
+    const std::vector<std::string>& getColumnsNames() const { return columnNames; }
+    int getColumnIndex(const std::string& columnName) const;
+
+    std::string getString(const int columnIndex) const;
+    std::string getString(const std::string& columnName) const;
+    ByteView getStringView(const int columnIndex) const;
+    int getInt(const int columnIndex) const;
+    int getInt(const std::string& columnName) const;
+    double getDouble(const int columnIndex) const;
+    double getDouble(const std::string& columnName) const;
+    long getLong(const int columnIndex) const;
+    long getLong(const std::string& columnName) const;
+    bool isNull(const int columnIndex) const;
+    Value::Type getType(const int columnIndex) const;
+
+    std::size_t getWindowSize() const { return windowSize_; }
+    /** Position of the first row in the current window. */
+    long long getWindowStart() const { return windowStart_; }
+    /** Number of windows read from the database so far. */
+    unsigned long long getWindowFills() const { return windowFills_; }
+
+private:
+    WindowedCursor(SQLiteDatabase& db, const std::string& table, const std::vector<std::string>& columns,
+                   const std::string& selection, const std::vector<Value>& selectionArgs, const std::size_t windowSize);
+
+    SQLiteDatabase* db_;
+
+    std::vector<std::string> columnNames;
+    std::map<std::string, int> columnNamesIndexMap;
+
+    std::vector<Value> selectionArgs_;
+    std::string keysetSql_;
+    std::string offsetSql_;
+    std::string countSql_;
+
+    std::size_t windowSize_;
+
+    // the current window, column 1 is the hidden rowid
+    Cursor window_;
+    long long windowStart_;
+    unsigned long long windowFills_;
+
+    // window start position to the last rowid before it, used to continue a scan without OFFSET
+    std::map<long long, long long> windowKeys_;
+
+    long long pos_;
+    long long count_;
+
+    Cursor fetchWindow(const long long windowStart);
+    int windowColumn(const int columnIndex) const;
+};
+
+} /* namespace sqlite */
+
+#endif /* WINDOWEDCURSOR_H */
@@ -0,0 +1,127 @@
+/*
+ * File:   BlobStream.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include <SQLiteDatabase.h>
+#include "BlobStream.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace sqlite {
+
+const std::size_t BlobStream::kDefaultChunkSize;
+
+BlobStream::BlobStream(sqlite3* db, sqlite3_blob* blob)
+        : db_(db), blob_(blob), size_(static_cast<std::size_t>(sqlite3_blob_bytes(blob))), pos_(0) {
+}
+
+BlobStream::BlobStream(BlobStream&& other)
+        : db_(other.db_), blob_(other.blob_), size_(other.size_), pos_(other.pos_) {
+    other.blob_ = nullptr;
+}
+
+BlobStream& BlobStream::operator=(BlobStream&& other) {
+    if (this != &other) {
+        close();
+
+        db_ = other.db_;
+        blob_ = other.blob_;
+        size_ = other.size_;
+        pos_ = other.pos_;
+
+        other.blob_ = nullptr;
+    }
+
+    return *this;
+}
+
+BlobStream::~BlobStream() {
+    // errors can't be reported from the destructor, call close() to see them
+    if (blob_ != nullptr) {
+        sqlite3_blob_close(blob_);
+    }
+}
+
+void BlobStream::seek(const std::size_t offset) {
+    pos_ = std::min(offset, size_);
+}
+
+std::size_t BlobStream::read(char* buffer, const std::size_t size) {
+    auto count = std::min(size, size_ - pos_);
+
+    if (count > 0) {
+        readAt(buffer, count, pos_);
+        pos_ += count;
+    }
+
+    return count;
+}
+
+void BlobStream::write(const char* data, const std::size_t size) {
+    writeAt(data, size, pos_);
+    pos_ += size;
+}
+
+void BlobStream::readAt(char* buffer, const std::size_t size, const std::size_t offset) {
+    checkRange(size, offset);
+    check(sqlite3_blob_read(blob_, buffer, static_cast<int>(size), static_cast<int>(offset)), "Error reading blob ");
+}
+
+void BlobStream::writeAt(const char* data, const std::size_t size, const std::size_t offset) {
+    checkRange(size, offset);
+    check(sqlite3_blob_write(blob_, data, static_cast<int>(size), static_cast<int>(offset)), "Error writing blob ");
+}
+
+void BlobStream::readChunks(const std::function<void(const char* data, std::size_t size)>& sink,
+                            const std::size_t chunkSize) {
+    std::vector<char> chunk(std::min(chunkSize == 0 ? kDefaultChunkSize : chunkSize, size_ - pos_));
+
+    std::size_t count;
+    while ((count = read(chunk.data(), chunk.size())) > 0) {
+        sink(chunk.data(), count);
+    }
+}
+
+void BlobStream::reopen(const long long rowid) {
+    if (blob_ == nullptr) {
+        throw SQLiteDatabaseException("Blob is closed");
+    }
+
+    check(sqlite3_blob_reopen(blob_, rowid), "Error reopening blob ");
+
+    size_ = static_cast<std::size_t>(sqlite3_blob_bytes(blob_));
+    pos_ = 0;
+}
+
+void BlobStream::close() {
+    if (blob_ == nullptr) {
+        return;
+    }
+
+    auto rc = sqlite3_blob_close(blob_);
+    blob_ = nullptr;
+
+    check(rc, "Error closing blob ");
+}
+
+void BlobStream::checkRange(const std::size_t size, const std::size_t offset) const {
+    if (blob_ == nullptr) {
+        throw SQLiteDatabaseException("Blob is closed");
+    }
+
+    if (offset > size_ || size > size_ - offset) {
+        throw SQLiteDatabaseException("Blob access out of range, a blob can't grow, reserve its size with zeroblob");
+    }
+}
+
+void BlobStream::check(const int rc, const std::string& msg) const {
+    if (rc != SQLITE_OK) {
+        throw SQLiteDatabaseException(msg + std::string(sqlite3_errmsg(db_)));
+    }
+}
+
+} /* namespace sqlite */
@@ -0,0 +1,109 @@
+/*
+ * File:   BoundStatement.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include <SQLiteDatabase.h>
+#include "BoundStatement.h"
+
+namespace sqlite {
+
+BoundStatement::BoundStatement() : stmt_(nullptr) {
+}
+
+BoundStatement::BoundStatement(sqlite3_stmt* stmt) : stmt_(stmt) {
+}
+
+BoundStatement::BoundStatement(BoundStatement&& other) : stmt_(other.stmt_) {
+    other.stmt_ = nullptr;
+}
+
+BoundStatement& BoundStatement::operator=(BoundStatement&& other) {
+    if (this != &other) {
+        sqlite3_finalize(stmt_);
+        stmt_ = other.stmt_;
+        other.stmt_ = nullptr;
+    }
+    return *this;
+}
+
+BoundStatement::~BoundStatement() {
+    sqlite3_finalize(stmt_);
+}
+
+std::string BoundStatement::getSql() const {
+    return stmt_ == nullptr ? std::string() : std::string(sqlite3_sql(stmt_));
+}
+
+int BoundStatement::getParameterCount() const {
+    return stmt_ == nullptr ? 0 : sqlite3_bind_parameter_count(stmt_);
+}
+
+void BoundStatement::checkBound(const std::size_t count, const int* results) {
+    if (stmt_ == nullptr) {
+        throw SQLiteDatabaseException("Statement is not prepared");
+    }
+
+    if (static_cast<int>(count) != sqlite3_bind_parameter_count(stmt_)) {
+        sqlite3_clear_bindings(stmt_);
+        throw SQLiteDatabaseException("Statement expects " + std::to_string(sqlite3_bind_parameter_count(stmt_)) +
+                                      " arguments, " + std::to_string(count) + " given");
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        if (results[i] != SQLITE_OK) {
+            std::string errorMsg = "Error binding argument " + std::to_string(i + 1) + " " +
+                                   sqlite3_errmsg(sqlite3_db_handle(stmt_));
+            sqlite3_clear_bindings(stmt_);
+            throw SQLiteDatabaseException(errorMsg);
+        }
+    }
+}
+
+int BoundStatement::step() {
+    int rc;
+    while ((rc = sqlite3_step(stmt_)) == SQLITE_ROW) {
+    }
+
+    auto db = sqlite3_db_handle(stmt_);
+    std::string errorMsg = rc == SQLITE_DONE ? std::string() : sqlite3_errmsg(db);
+
+    // bound text is SQLITE_STATIC, don't keep pointers to the caller's arguments
+    sqlite3_reset(stmt_);
+    sqlite3_clear_bindings(stmt_);
+
+    if (rc != SQLITE_DONE) {
+        throw SQLiteDatabaseException("Error executing statement " + errorMsg);
+    }
+
+    return sqlite3_changes(db);
+}
+
+Cursor BoundStatement::fetch() {
+    Cursor c;
+
+    auto cols = sqlite3_column_count(stmt_);
+    for (auto col = 0; col < cols; col++) {
+        c.addColumn(std::string(sqlite3_column_name(stmt_, col)));
+    }
+
+    int rc;
+    while ((rc = sqlite3_step(stmt_)) == SQLITE_ROW) {
+        c.addRow(stmt_);
+    }
+
+    std::string errorMsg = rc == SQLITE_DONE ? std::string() : sqlite3_errmsg(sqlite3_db_handle(stmt_));
+
+    sqlite3_reset(stmt_);
+    sqlite3_clear_bindings(stmt_);
+
+    if (rc != SQLITE_DONE) {
+        throw SQLiteDatabaseException("Failed to query database " + errorMsg);
+    }
+
+    return c;
+}
+
+} /* namespace sqlite */
@@ -0,0 +1,138 @@
+/*
+ * File:   BusyPolicy.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include "BusyPolicy.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace sqlite {
+
+const int BusyPolicy::kDefaultInitialDelayMs;
+const int BusyPolicy::kDefaultMaxDelayMs;
+
+BusyPolicy::BusyPolicy()
+        : kind_(None), maxWaitMs_(0), initialDelayMs_(kDefaultInitialDelayMs), maxDelayMs_(kDefaultMaxDelayMs) {
+}
+
+BusyPolicy BusyPolicy::timeout(const int milliseconds) {
+    BusyPolicy policy;
+    policy.kind_ = Timeout;
+    policy.maxWaitMs_ = milliseconds;
+    return policy;
+}
+
+BusyPolicy BusyPolicy::backoff(const int maxWaitMs, const int initialDelayMs, const int maxDelayMs) {
+    BusyPolicy policy;
+    policy.kind_ = Backoff;
+    policy.maxWaitMs_ = maxWaitMs;
+    policy.initialDelayMs_ = std::max(initialDelayMs, 1);
+    policy.maxDelayMs_ = std::max(maxDelayMs, policy.initialDelayMs_);
+    return policy;
+}
+
+BusyPolicy BusyPolicy::custom(const Handler& handler) {
+    BusyPolicy policy;
+    policy.kind_ = handler ? Custom : None;
+    policy.handler_ = handler;
+    return policy;
+}
+
+BusyHandler::BusyHandler(const BusyPolicy& policy)
+        : policy_(policy), waited_(0), random_(std::random_device()()) {
+}
+
+BusyHandler::~BusyHandler() {
+}
+
+void BusyHandler::install(sqlite3* db) {
+    if (policy_.kind_ == BusyPolicy::None) {
+        sqlite3_busy_handler(db, nullptr, nullptr);
+    }
+    else {
+        sqlite3_busy_handler(db, callback, this);
+    }
+}
+
+LockWaitStats BusyHandler::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void BusyHandler::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = LockWaitStats();
+}
+
+bool BusyHandler::retry(const int count) {
+    // same steps as sqlite3_busy_timeout
+    static const int kTimeoutDelays[] = {1, 2, 5, 10, 15, 20, 25, 25, 25, 50, 50, 100};
+    static const int kTimeoutSteps = sizeof(kTimeoutDelays) / sizeof(kTimeoutDelays[0]);
+
+    auto remaining = std::chrono::milliseconds(policy_.maxWaitMs_) - waited_;
+    std::chrono::microseconds delay(0);
+
+    switch (policy_.kind_) {
+        case BusyPolicy::Timeout:
+            delay = std::chrono::milliseconds(kTimeoutDelays[std::min(count, kTimeoutSteps - 1)]);
+            break;
+        case BusyPolicy::Backoff: {
+            long long base = policy_.maxDelayMs_ * 1000LL;
+            if (count < 30) {
+                base = std::min(base, (policy_.initialDelayMs_ * 1000LL) << count);
+            }
+            std::uniform_int_distribution<long long> jitter(base / 2, base);
+            delay = std::chrono::microseconds(jitter(random_));
+            break;
+        }
+        case BusyPolicy::Custom:
+            return policy_.handler_(count);
+        default:
+            return false;
+    }
+
+    if (remaining <= std::chrono::nanoseconds(0)) {
+        return false;
+    }
+
+    std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(delay, remaining));
+    return true;
+}
+
+int BusyHandler::callback(void* context, int count) {
+    auto handler = static_cast<BusyHandler*>(context);
+
+    // count restarts at 0 for every new lock wait
+    if (count == 0) {
+        handler->waited_ = std::chrono::nanoseconds(0);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto retry = handler->retry(count);
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    handler->waited_ += elapsed;
+
+    std::lock_guard<std::mutex> lock(handler->mutex_);
+
+    auto& stats = handler->stats_;
+    if (count == 0) {
+        stats.waits++;
+    }
+    if (retry) {
+        stats.retries++;
+    }
+    else {
+        stats.timeouts++;
+    }
+    stats.waitTime += elapsed.count();
+    stats.maxWaitTime = std::max<long long>(stats.maxWaitTime, handler->waited_.count());
+
+    return retry ? 1 : 0;
+}
+
+} /* namespace sqlite */
@@ -8,16 +8,32 @@
 #include <SQLiteDatabase.h>
 #include "Cursor.h"
 
+#include <cstdlib>
+
 namespace sqlite {
 
-Cursor::Cursor() : count_(0), pos_(-1) {
+Cursor::Cursor() : table_(std::make_shared<Table>()), pos_(-1) {
 }
 
 Cursor::~Cursor() {
 }
 
+Cursor::Cursor(const Cursor& orig) = default;
+
+// moves share the result set like copies so a moved from cursor is still a valid cursor
+Cursor::Cursor(Cursor&& orig) : table_(orig.table_), pos_(orig.pos_) {
+}
+
+Cursor& Cursor::operator=(const Cursor& orig) = default;
+
+Cursor& Cursor::operator=(Cursor&& orig) {
+    table_ = orig.table_;
+    pos_ = orig.pos_;
+    return *this;
+}
+
 bool Cursor::next() {
-    if(pos_ < count_){
+    if(pos_ + 1 < table_->count){
         pos_++;
         return true;
     }
@@ -26,53 +42,260 @@ bool Cursor::next() {
     }
 }
 
+bool Cursor::moveToPosition(const int position) {
+    if(position < 0 || position >= table_->count){
+        return false;
+    }
+
+    pos_ = position;
+    return true;
+}
+
 int Cursor::getColumnIndex(const std::string& columnName) const{
-    return columnNamesIndexMap.at(columnName);
+    return table_->columnNamesIndexMap.at(columnName);
+}
+
+const Cursor::Cell& Cursor::getCell(const int columnIndex) const {
+    auto cols = table_->columnNames.size();
+
+    if(columnIndex < 1 || columnIndex > cols){
+        throw SQLiteDatabaseException("Invalid column index");
+    }
+
+    if(pos_ < 0 || pos_ >= table_->count){
+        throw SQLiteDatabaseException("Cursor is not positioned on a row");
+    }
+
+    return table_->cells[pos_ * cols + columnIndex - 1];
+}
+
+Value Cursor::getValue(const int columnIndex) const {
+    auto& cell = getCell(columnIndex);
+
+    switch (cell.type) {
+        case Value::Integer:
+            return Value(cell.integer);
+        case Value::Float:
+            return Value(cell.real);
+        case Value::Text:
+            return Value(std::string(&table_->data[cell.offset], cell.size));
+        case Value::Blob:
+            return Value::blob(&table_->data[cell.offset], cell.size);
+        default:
+            return Value();
+    }
+}
+
+ByteView Cursor::getStringView(const int columnIndex) const {
+    auto& cell = getCell(columnIndex);
+
+    if (cell.type != Value::Text && cell.type != Value::Blob) {
+        return ByteView();
+    }
+
+    return ByteView(&table_->data[cell.offset], cell.size);
+}
+
+ByteView Cursor::getStringView(std::string columnName) const {
+    return getStringView(getColumnIndex(columnName) + 1);
+}
+
+ByteView Cursor::getBlob(const int columnIndex) const {
+    return getStringView(columnIndex);
+}
+
+ByteView Cursor::getBlob(std::string columnName) const {
+    return getBlob(getColumnIndex(columnName) + 1);
 }
 
 std::string Cursor::getString(const int columnIndex) const {
-    if(columnIndex < 0 || columnIndex > columnNames.size()){
-        throw new SQLiteDatabaseException("Invalid column index");
+    auto& cell = getCell(columnIndex);
+
+    switch (cell.type) {
+        case Value::Text:
+        case Value::Blob:
+            return std::string(&table_->data[cell.offset], cell.size);
+        case Value::Null:
+            return std::string();
+        default:
+            return getValue(columnIndex).asString();
     }
+}
 
-    return rs[pos_][columnIndex - 1];
+std::string Cursor::getString(const std::string columnName) const {
+    return getString(getColumnIndex(columnName) + 1);
 }
 
 int Cursor::getInt(const int columnIndex) const {
-    if(columnIndex < 0 || columnIndex > columnNames.size()){
-        throw new SQLiteDatabaseException("Invalid column index");
+    return static_cast<int>(getLong(columnIndex));
+}
+
+int Cursor::getInt(std::string columnName) const {
+    return getInt(getColumnIndex(columnName) + 1);
+}
+
+double Cursor::getDouble(const int columnIndex) const {
+    auto& cell = getCell(columnIndex);
+
+    switch (cell.type) {
+        case Value::Integer:
+            return static_cast<double>(cell.integer);
+        case Value::Float:
+            return cell.real;
+        case Value::Text:
+            return std::strtod(&table_->data[cell.offset], nullptr);
+        default:
+            return 0.0;
     }
+}
 
-    return stoi(rs[pos_][columnIndex - 1]);
+double Cursor::getDouble(std::string columnName) const {
+    return getDouble(getColumnIndex(columnName) + 1);
 }
 
 long Cursor::getLong(const int columnIndex) const {
-    if(columnIndex < 0 || columnIndex > columnNames.size()){
-        throw new SQLiteDatabaseException("Invalid column index");
+    auto& cell = getCell(columnIndex);
+
+    switch (cell.type) {
+        case Value::Integer:
+            return static_cast<long>(cell.integer);
+        case Value::Float:
+            return static_cast<long>(cell.real);
+        case Value::Text:
+            return std::strtol(&table_->data[cell.offset], nullptr, 10);
+        default:
+            return 0;
+    }
+}
+
+long Cursor::getLong(std::string columnName) const {
+    return getLong(getColumnIndex(columnName) + 1);
+}
+
+bool Cursor::isNull(const int columnIndex) const {
+    return getCell(columnIndex).type == Value::Null;
+}
+
+bool Cursor::isNull(std::string columnName) const {
+    return isNull(getColumnIndex(columnName) + 1);
+}
+
+Value::Type Cursor::getType(const int columnIndex) const {
+    return getCell(columnIndex).type;
+}
+
+std::size_t Cursor::getMemoryUsage() const {
+    auto usage = sizeof(Table) + table_->cells.capacity() * sizeof(Cell) + table_->data.capacity();
+
+    for (auto& name : table_->columnNames) {
+        // the name is held by the vector and the index map
+        usage += 2 * (sizeof(std::string) + name.capacity()) + sizeof(int);
     }
 
-    return stol(rs[pos_][columnIndex - 1]);
+    return usage;
 }
 
-void Cursor::addRow(const std::vector<std::string>& resultRow){    
-    rs.push_back(resultRow);
-    count_++;
+Cursor::Table& Cursor::mutableTable() {
+    if (table_.use_count() > 1) {
+        table_ = std::make_shared<Table>(*table_);
+    }
+
+    return *table_;
+}
+
+void Cursor::addColumn(const std::string& columnName) {
+    auto& table = mutableTable();
+
+    table.columnNamesIndexMap[columnName] = static_cast<int>(table.columnNames.size());
+    table.columnNames.push_back(columnName);
+}
+
+void Cursor::addRow(sqlite3_stmt* stmt){
+    auto& table = mutableTable();
+    auto cols = static_cast<int>(table.columnNames.size());
+
+    for (auto col = 0; col < cols; col++) {
+        Cell cell;
+        cell.integer = 0;
+        cell.size = 0;
+        cell.type = static_cast<Value::Type>(sqlite3_column_type(stmt, col));
+
+        switch (cell.type) {
+            case Value::Integer:
+                cell.integer = sqlite3_column_int64(stmt, col);
+                break;
+            case Value::Float:
+                cell.real = sqlite3_column_double(stmt, col);
+                break;
+            case Value::Text: {
+                auto text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, col));
+                appendBytes(table, cell, text, sqlite3_column_bytes(stmt, col));
+                break;
+            }
+            case Value::Blob: {
+                // sqlite3_column_blob must be called before sqlite3_column_bytes
+                auto blob = static_cast<const char*>(sqlite3_column_blob(stmt, col));
+                appendBytes(table, cell, blob, sqlite3_column_bytes(stmt, col));
+                break;
+            }
+            default:
+                break;
+        }
+
+        table.cells.push_back(cell);
+    }
+
+    table.count++;
+}
+
+void Cursor::addRow(const std::vector<Value>& resultRow){
+    auto& table = mutableTable();
+
+    for (auto& value : resultRow) {
+        Cell cell;
+        cell.integer = 0;
+        cell.size = 0;
+        cell.type = value.type();
+
+        switch (cell.type) {
+            case Value::Integer:
+                cell.integer = value.asInt64();
+                break;
+            case Value::Float:
+                cell.real = value.asDouble();
+                break;
+            case Value::Text:
+            case Value::Blob:
+                appendBytes(table, cell, value.bytes().data(), value.bytes().size());
+                break;
+            default:
+                break;
+        }
+
+        table.cells.push_back(cell);
+    }
+
+    table.count++;
+}
+
+void Cursor::appendBytes(Table& table, Cell& cell, const char* bytes, const std::size_t size) {
+    cell.offset = table.data.size();
+    cell.size = size;
+
+    table.data.insert(table.data.end(), bytes, bytes + size);
+    table.data.push_back('\0');
 }
 
 void Cursor::reset(){
-    // Reset count_ and position
+    // Reset position
     pos_ = -1;
-    count_ = 0;
-    
-    // Clear Result Set
-    rs.clear();
-    
-    // Clear column name to index mapping
-    columnNames.clear();
+
+    // Drop the result set and column name to index mapping, copies keep theirs
+    table_ = std::make_shared<Table>();
 }
 
 bool Cursor::hasNext() {
-    return (pos_++ < count_);
+    return (pos_++ < table_->count);
 }
 
 } /* namespace sqlite */
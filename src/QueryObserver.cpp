@@ -0,0 +1,458 @@
+/*
+ * File:   QueryObserver.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include <SQLiteDatabase.h>
+#include "QueryObserver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+
+namespace sqlite {
+
+namespace {
+
+// Encodes the row the cursor is on so equal rows get equal keys, type tags keep 1, 1.0 and '1' apart
+std::string rowKey(const Cursor& cursor) {
+    std::string key;
+
+    auto cols = static_cast<int>(cursor.getColumnsNames().size());
+    for (auto col = 1; col <= cols; col++) {
+        auto value = cursor.getValue(col);
+        key += static_cast<char>('0' + value.type());
+
+        switch (value.type()) {
+            case Value::Integer: {
+                auto integer = value.asInt64();
+                key.append(reinterpret_cast<const char*>(&integer), sizeof(integer));
+                break;
+            }
+            case Value::Float: {
+                auto real = value.asDouble();
+                key.append(reinterpret_cast<const char*>(&real), sizeof(real));
+                break;
+            }
+            case Value::Text:
+            case Value::Blob:
+                key += std::to_string(value.bytes().size());
+                key += ':';
+                key += value.bytes();
+                break;
+            default:
+                break;
+        }
+    }
+
+    return key;
+}
+
+} /* namespace */
+
+QuerySubscription::QuerySubscription() : id_(-1) {
+}
+
+QuerySubscription::QuerySubscription(const std::shared_ptr<QueryObserver>& observer, const int id)
+        : observer_(observer), id_(id) {
+}
+
+QuerySubscription::QuerySubscription(QuerySubscription&& other)
+        : observer_(std::move(other.observer_)), id_(other.id_) {
+    other.observer_.reset();
+    other.id_ = -1;
+}
+
+QuerySubscription& QuerySubscription::operator=(QuerySubscription&& other) {
+    if (this != &other) {
+        cancel();
+        observer_ = std::move(other.observer_);
+        id_ = other.id_;
+        other.observer_.reset();
+        other.id_ = -1;
+    }
+    return *this;
+}
+
+QuerySubscription::~QuerySubscription() {
+    cancel();
+}
+
+void QuerySubscription::cancel() {
+    auto observer = observer_.lock();
+
+    if (observer && id_ >= 0) {
+        observer->unsubscribe(id_);
+    }
+
+    observer_.reset();
+    id_ = -1;
+}
+
+bool QuerySubscription::isActive() const {
+    auto observer = observer_.lock();
+
+    if (!observer || id_ < 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(observer->mutex_);
+    return observer->queries_.count(id_) != 0;
+}
+
+const int QueryObserver::kDefaultCoalesceDelayMs;
+
+QueryObserver::QueryObserver(sqlite3* db, TableChangeTracker& tracker)
+        : db_(db), tracker_(tracker), listener_(-1), nextId_(0), dirty_(false), stopping_(false),
+          delayMs_(kDefaultCoalesceDelayMs), reruns_(0) {
+    listener_ = tracker_.addListener([this](const std::set<std::string>& tables, bool allTables) {
+        markDirty(tables, allTables);
+    });
+
+    thread_ = std::thread(&QueryObserver::run, this);
+}
+
+QueryObserver::~QueryObserver() {
+    stop();
+}
+
+QuerySubscription QueryObserver::subscribe(const std::string& sql, const std::vector<Value>& args,
+                                           const Callback& callback) {
+    auto query = std::make_shared<Query>();
+    query->tables = tracker_.tablesRead(sql);
+    query->args = args;
+    query->callback = callback;
+    query->dirty = false;
+    query->delivered = false;
+    query->stmt = nullptr;
+
+    // the query keeps its own statement so re-runs never wait on the statement cache
+    auto rc = sqlite3_prepare_v2(db_, sql.c_str(), static_cast<int>(sql.size()), &query->stmt, nullptr);
+    if (rc != SQLITE_OK) {
+        sqlite3_finalize(query->stmt);
+        throw SQLiteDatabaseException("Error preparing observed query " + std::string(sqlite3_errmsg(db_)));
+    }
+
+    std::lock_guard<std::recursive_mutex> callbacks(callbackMutex_);
+
+    // held like dispatch does so no transaction can start between the autocommit check and the first run
+    auto connectionMutex = sqlite3_db_mutex(db_);
+    sqlite3_mutex_enter(connectionMutex);
+
+    // inside a transaction the first run is left to the dispatcher so it never sees uncommitted rows
+    auto deferred = !sqlite3_get_autocommit(db_);
+
+    int id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (stopping_) {
+            sqlite3_mutex_leave(connectionMutex);
+            sqlite3_finalize(query->stmt);
+            throw SQLiteDatabaseException("Query observer is stopped");
+        }
+
+        // registered before the first run so a commit in between marks it dirty
+        id = nextId_++;
+        queries_[id] = query;
+
+        if (deferred) {
+            query->dirty = true;
+            dirty_ = true;
+            wake_.notify_one();
+        }
+    }
+
+    QuerySubscription subscription(shared_from_this(), id);
+
+    if (deferred) {
+        sqlite3_mutex_leave(connectionMutex);
+        return subscription;
+    }
+
+    std::string error;
+    auto result = execute(*query, error);
+
+    sqlite3_mutex_leave(connectionMutex);
+
+    if (!error.empty()) {
+        throw SQLiteDatabaseException("Error running observed query " + error);
+    }
+
+    query->last = result;
+    query->delivered = true;
+    callback(diff(Cursor(), result));
+
+    return subscription;
+}
+
+void QueryObserver::unsubscribe(const int id) {
+    std::lock_guard<std::recursive_mutex> callbacks(callbackMutex_);
+
+    std::shared_ptr<Query> query;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = queries_.find(id);
+        if (it == queries_.end()) {
+            return;
+        }
+
+        query = it->second;
+        queries_.erase(it);
+    }
+
+    sqlite3_finalize(query->stmt);
+    query->stmt = nullptr;
+}
+
+void QueryObserver::setCoalesceDelay(const int milliseconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    delayMs_ = milliseconds;
+}
+
+std::size_t QueryObserver::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queries_.size();
+}
+
+unsigned long long QueryObserver::reruns() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reruns_;
+}
+
+void QueryObserver::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    if (listener_ >= 0) {
+        tracker_.removeListener(listener_);
+        listener_ = -1;
+
+        // a commit hook that copied the listener before it was removed runs under the connection mutex
+        auto connectionMutex = sqlite3_db_mutex(db_);
+        sqlite3_mutex_enter(connectionMutex);
+        sqlite3_mutex_leave(connectionMutex);
+    }
+
+    std::lock_guard<std::recursive_mutex> callbacks(callbackMutex_);
+    std::map<int, std::shared_ptr<Query>> queries;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queries.swap(queries_);
+    }
+
+    for (auto& query : queries) {
+        sqlite3_finalize(query.second->stmt);
+        query.second->stmt = nullptr;
+    }
+}
+
+void QueryObserver::markDirty(const std::set<std::string>& tables, const bool allTables) {
+    // called from the commit hook, only flag the queries, the connection can't be used here
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto& query : queries_) {
+        if (query.second->dirty) {
+            continue;
+        }
+
+        auto& reads = query.second->tables;
+        if (allTables || std::any_of(reads.begin(), reads.end(),
+                                     [&tables](const std::string& table) { return tables.count(table) != 0; })) {
+            query.second->dirty = true;
+            dirty_ = true;
+        }
+    }
+
+    if (dirty_) {
+        wake_.notify_one();
+    }
+}
+
+void QueryObserver::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!stopping_) {
+        wake_.wait(lock, [this] { return stopping_ || dirty_; });
+
+        // commits arriving during the delay share one re-run
+        wake_.wait_for(lock, std::chrono::milliseconds(delayMs_), [this] { return stopping_; });
+
+        if (stopping_) {
+            break;
+        }
+
+        lock.unlock();
+        auto dispatched = dispatch();
+        lock.lock();
+
+        // the connection is inside a transaction, check again later
+        if (!dispatched) {
+            wake_.wait_for(lock, std::chrono::milliseconds(std::max(delayMs_, 1)), [this] { return stopping_; });
+        }
+    }
+}
+
+bool QueryObserver::dispatch() {
+    std::lock_guard<std::recursive_mutex> callbacks(callbackMutex_);
+
+    std::vector<std::pair<int, std::shared_ptr<Query>>> dirty;
+    std::vector<Cursor> results;
+    std::vector<std::string> errors;
+
+    // hold the connection mutex so no transaction can start while the queries run
+    auto connectionMutex = sqlite3_db_mutex(db_);
+    sqlite3_mutex_enter(connectionMutex);
+
+    if (!sqlite3_get_autocommit(db_)) {
+        sqlite3_mutex_leave(connectionMutex);
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (auto& query : queries_) {
+            if (query.second->dirty) {
+                query.second->dirty = false;
+                dirty.push_back(query);
+            }
+        }
+
+        dirty_ = false;
+        reruns_ += dirty.size();
+    }
+
+    for (auto& query : dirty) {
+        std::string error;
+        results.push_back(execute(*query.second, error));
+        errors.push_back(error);
+    }
+
+    sqlite3_mutex_leave(connectionMutex);
+
+    for (std::size_t i = 0; i < dirty.size(); i++) {
+        auto& query = *dirty[i].second;
+
+        {
+            // a callback that ran before this one may have cancelled it
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (queries_.count(dirty[i].first) == 0) {
+                continue;
+            }
+        }
+
+        QueryChange change;
+
+        if (errors[i].empty()) {
+            change = diff(query.last, results[i]);
+
+            // the first result is delivered even if it is empty
+            if (query.delivered && change.added.empty() && change.removed.empty()) {
+                continue;
+            }
+
+            query.last = results[i];
+        }
+        else {
+            change.result = query.last;
+            change.previous = query.last;
+            change.error = errors[i];
+        }
+
+        query.delivered = true;
+
+        // an exception would end the dispatcher thread, the other callbacks still have to run
+        try {
+            query.callback(change);
+        }
+        catch (...) {
+        }
+    }
+
+    return true;
+}
+
+Cursor QueryObserver::execute(Query& query, std::string& error) {
+    Cursor c;
+
+    sqlite3_reset(query.stmt);
+
+    for (std::size_t i = 0; i < query.args.size(); i++) {
+        if (query.args[i].bind(query.stmt, static_cast<int>(i) + 1) != SQLITE_OK) {
+            error = sqlite3_errmsg(db_);
+            return c;
+        }
+    }
+
+    auto cols = sqlite3_column_count(query.stmt);
+    for (auto col = 0; col < cols; col++) {
+        c.addColumn(std::string(sqlite3_column_name(query.stmt, col)));
+    }
+
+    int rc;
+    while ((rc = sqlite3_step(query.stmt)) == SQLITE_ROW) {
+        c.addRow(query.stmt);
+    }
+
+    if (rc != SQLITE_DONE) {
+        error = sqlite3_errmsg(db_);
+    }
+
+    sqlite3_reset(query.stmt);
+
+    return c;
+}
+
+QueryChange QueryObserver::diff(const Cursor& previous, const Cursor& result) {
+    QueryChange change;
+    change.result = result;
+    change.previous = previous;
+
+    // copies share the result sets, moving them leaves the positions of the originals alone
+    Cursor before = previous;
+    Cursor after = result;
+
+    // with different columns no row can match
+    auto sameColumns = before.getColumnsNames() == after.getColumnsNames();
+
+    std::unordered_map<std::string, std::vector<int>> rows;
+    for (auto row = 0; before.moveToPosition(row); row++) {
+        if (sameColumns) {
+            rows[rowKey(before)].push_back(row);
+        }
+        else {
+            change.removed.push_back(row);
+        }
+    }
+
+    for (auto row = 0; after.moveToPosition(row); row++) {
+        auto it = sameColumns ? rows.find(rowKey(after)) : rows.end();
+
+        if (it != rows.end() && !it->second.empty()) {
+            it->second.pop_back();
+        }
+        else {
+            change.added.push_back(row);
+        }
+    }
+
+    for (auto& unmatched : rows) {
+        change.removed.insert(change.removed.end(), unmatched.second.begin(), unmatched.second.end());
+    }
+    std::sort(change.removed.begin(), change.removed.end());
+
+    return change;
+}
+
+} /* namespace sqlite */
@@ -0,0 +1,195 @@
+/*
+ * File:   ResultCache.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include "ResultCache.h"
+
+#include <iterator>
+
+namespace sqlite {
+
+const std::size_t ResultCache::kDefaultMaxBytes;
+
+ResultCache::ResultCache(const std::size_t maxBytes)
+        : maxBytes_(maxBytes), bytes_(0), generation_(0), hits_(0), misses_(0), invalidations_(0), evictions_(0) {
+}
+
+ResultCache::~ResultCache() {
+}
+
+std::string ResultCache::makeKey(const std::string& sql, const std::vector<Value>& args) {
+    std::string key = sql;
+
+    // type tag and length prefix so 1, 1.0 and '1' and values with embedded separators never collide
+    for (auto& arg : args) {
+        auto bytes = (arg.type() == Value::Text || arg.type() == Value::Blob) ? arg.bytes() : arg.asString();
+
+        key += '\0';
+        key += static_cast<char>('0' + arg.type());
+        key += std::to_string(bytes.size());
+        key += ':';
+        key += bytes;
+    }
+
+    return key;
+}
+
+std::shared_ptr<const Cursor> ResultCache::get(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = index_.find(key);
+
+    if (it == index_.end()) {
+        misses_++;
+        return nullptr;
+    }
+
+    hits_++;
+    lru_.splice(lru_.begin(), lru_, it->second);
+
+    return it->second->cursor;
+}
+
+unsigned long long ResultCache::generation() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return generation_;
+}
+
+void ResultCache::put(const std::string& key, const Cursor& cursor, const std::set<std::string>& tables,
+                      const unsigned long long generation) {
+    auto bytes = cursor.getMemoryUsage() + key.size() + sizeof(Entry);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (generation != generation_ || bytes > maxBytes_) {
+        return;
+    }
+
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        erase(it->second);
+    }
+
+    Entry entry;
+    entry.key = key;
+    entry.cursor = std::make_shared<const Cursor>(cursor);
+    entry.tables = tables;
+    entry.bytes = bytes;
+
+    lru_.push_front(entry);
+    index_[key] = lru_.begin();
+    bytes_ += bytes;
+
+    for (auto& table : tables) {
+        tableKeys_[table].insert(key);
+    }
+
+    evict(maxBytes_);
+}
+
+void ResultCache::invalidate(const std::set<std::string>& tables) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    generation_++;
+
+    for (auto& table : tables) {
+        auto keys = tableKeys_.find(table);
+
+        if (keys == tableKeys_.end()) {
+            continue;
+        }
+
+        // erase edits tableKeys_, work from a copy
+        auto stale = keys->second;
+        for (auto& key : stale) {
+            auto it = index_.find(key);
+            if (it != index_.end()) {
+                erase(it->second);
+                invalidations_++;
+            }
+        }
+    }
+}
+
+void ResultCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    generation_++;
+    invalidations_ += lru_.size();
+
+    lru_.clear();
+    index_.clear();
+    tableKeys_.clear();
+    bytes_ = 0;
+}
+
+void ResultCache::setMaxBytes(const std::size_t maxBytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxBytes_ = maxBytes;
+    evict(maxBytes_);
+}
+
+std::size_t ResultCache::maxBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return maxBytes_;
+}
+
+std::size_t ResultCache::bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+}
+
+std::size_t ResultCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_.size();
+}
+
+unsigned long long ResultCache::hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+unsigned long long ResultCache::misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+unsigned long long ResultCache::invalidations() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return invalidations_;
+}
+
+unsigned long long ResultCache::evictions() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return evictions_;
+}
+
+void ResultCache::erase(EntryList::iterator entry) {
+    // caller holds mutex_
+    for (auto& table : entry->tables) {
+        auto keys = tableKeys_.find(table);
+        if (keys != tableKeys_.end()) {
+            keys->second.erase(entry->key);
+            if (keys->second.empty()) {
+                tableKeys_.erase(keys);
+            }
+        }
+    }
+
+    bytes_ -= entry->bytes;
+    index_.erase(entry->key);
+    lru_.erase(entry);
+}
+
+void ResultCache::evict(const std::size_t maxBytes) {
+    // caller holds mutex_
+    while (bytes_ > maxBytes && !lru_.empty()) {
+        erase(std::prev(lru_.end()));
+        evictions_++;
+    }
+}
+
+} /* namespace sqlite */
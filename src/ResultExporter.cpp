@@ -0,0 +1,350 @@
+/*
+ * File:   ResultExporter.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include <SQLiteDatabase.h>
+#include "ResultExporter.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace sqlite {
+
+namespace {
+
+void writeFd(const int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+#ifdef _WIN32
+        auto written = _write(fd, data, static_cast<unsigned int>(size));
+#else
+        auto written = ::write(fd, data, size);
+#endif
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw SQLiteDatabaseException("Error writing export: " + std::string(std::strerror(errno)));
+        }
+
+        data += written;
+        size -= written;
+    }
+}
+
+// Writes the JSON escape sequence for c into out and returns its length, 0 if c is written as is
+std::size_t jsonEscape(const unsigned char c, char* out) {
+    switch (c) {
+        case '"': std::memcpy(out, "\\\"", 2); return 2;
+        case '\\': std::memcpy(out, "\\\\", 2); return 2;
+        case '\n': std::memcpy(out, "\\n", 2); return 2;
+        case '\r': std::memcpy(out, "\\r", 2); return 2;
+        case '\t': std::memcpy(out, "\\t", 2); return 2;
+        default:
+            if (c < 0x20) {
+                std::snprintf(out, 7, "\\u%04x", c);
+                return 6;
+            }
+            return 0;
+    }
+}
+
+} /* namespace */
+
+const std::size_t ResultExporter::kDefaultBlockSize;
+
+ResultExporter::ResultExporter(const Sink& sink, const Format format, const std::size_t blockSize)
+        : sink_(sink), format_(format), blockSize_(blockSize == 0 ? kDefaultBlockSize : blockSize),
+          bytesWritten_(0) {
+    buffer_.reserve(blockSize_);
+}
+
+ResultExporter::ResultExporter(const int fd, const Format format, const std::size_t blockSize)
+        : ResultExporter([fd](const char* data, std::size_t size) { writeFd(fd, data, size); }, format, blockSize) {
+}
+
+ResultExporter::ResultExporter(std::ostream& stream, const Format format, const std::size_t blockSize)
+        : ResultExporter([&stream](const char* data, std::size_t size) {
+                             if (!stream.write(data, static_cast<std::streamsize>(size))) {
+                                 throw SQLiteDatabaseException("Error writing export to stream");
+                             }
+                         }, format, blockSize) {
+}
+
+ResultExporter::~ResultExporter() {
+    try {
+        flush();
+    }
+    catch (...) {
+    }
+}
+
+void ResultExporter::writeHeader(sqlite3_stmt* stmt) {
+    auto cols = sqlite3_column_count(stmt);
+
+    switch (format_) {
+        case Csv:
+            for (auto col = 0; col < cols; col++) {
+                if (col > 0) {
+                    append(',');
+                }
+                auto name = sqlite3_column_name(stmt, col);
+                appendCsvField(name, std::strlen(name));
+            }
+            append("\r\n", 2);
+            break;
+        case JsonLines:
+            // keys are the same on every row, escape them once
+            jsonKeys_.clear();
+            for (auto col = 0; col < cols; col++) {
+                auto name = sqlite3_column_name(stmt, col);
+                std::string key = "\"";
+                char escaped[8];
+                for (auto c = name; *c != '\0'; c++) {
+                    auto size = jsonEscape(static_cast<unsigned char>(*c), escaped);
+                    key += size > 0 ? std::string(escaped, size) : std::string(1, *c);
+                }
+                jsonKeys_.push_back(key + "\":");
+            }
+            break;
+        case Binary:
+            append("CQLB", 4);
+            appendUInt32(static_cast<unsigned int>(cols));
+            for (auto col = 0; col < cols; col++) {
+                auto name = sqlite3_column_name(stmt, col);
+                auto size = std::strlen(name);
+                appendUInt32(static_cast<unsigned int>(size));
+                append(name, size);
+            }
+            break;
+    }
+}
+
+void ResultExporter::writeRow(sqlite3_stmt* stmt) {
+    auto cols = sqlite3_column_count(stmt);
+
+    if (format_ == JsonLines) {
+        append('{');
+    }
+
+    for (auto col = 0; col < cols; col++) {
+        auto type = sqlite3_column_type(stmt, col);
+
+        if (format_ == Binary) {
+            append(static_cast<char>(type));
+
+            switch (type) {
+                case SQLITE_INTEGER:
+                    appendUInt64(static_cast<unsigned long long>(sqlite3_column_int64(stmt, col)));
+                    break;
+                case SQLITE_FLOAT: {
+                    auto real = sqlite3_column_double(stmt, col);
+                    unsigned long long bits;
+                    std::memcpy(&bits, &real, sizeof(bits));
+                    appendUInt64(bits);
+                    break;
+                }
+                case SQLITE_TEXT:
+                case SQLITE_BLOB: {
+                    auto data = type == SQLITE_TEXT ? reinterpret_cast<const char*>(sqlite3_column_text(stmt, col))
+                                                    : static_cast<const char*>(sqlite3_column_blob(stmt, col));
+                    auto size = static_cast<std::size_t>(sqlite3_column_bytes(stmt, col));
+                    appendUInt32(static_cast<unsigned int>(size));
+                    append(data, size);
+                    break;
+                }
+                default:
+                    break;
+            }
+            continue;
+        }
+
+        if (col > 0) {
+            append(',');
+        }
+
+        if (format_ == JsonLines) {
+            append(jsonKeys_[col]);
+        }
+
+        switch (type) {
+            case SQLITE_INTEGER:
+            case SQLITE_FLOAT:
+                appendNumber(stmt, col);
+                break;
+            case SQLITE_TEXT: {
+                auto text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, col));
+                auto size = static_cast<std::size_t>(sqlite3_column_bytes(stmt, col));
+                if (format_ == Csv) {
+                    appendCsvField(text, size);
+                }
+                else {
+                    appendJsonString(text, size);
+                }
+                break;
+            }
+            case SQLITE_BLOB: {
+                auto blob = static_cast<const unsigned char*>(sqlite3_column_blob(stmt, col));
+                auto size = static_cast<std::size_t>(sqlite3_column_bytes(stmt, col));
+                if (format_ == JsonLines) {
+                    append('"');
+                }
+                appendHex(blob, size);
+                if (format_ == JsonLines) {
+                    append('"');
+                }
+                break;
+            }
+            default:
+                if (format_ == JsonLines) {
+                    append("null", 4);
+                }
+                break;
+        }
+    }
+
+    if (format_ == Csv) {
+        append("\r\n", 2);
+    }
+    else if (format_ == JsonLines) {
+        append("}\n", 2);
+    }
+}
+
+void ResultExporter::flush() {
+    if (buffer_.empty()) {
+        return;
+    }
+
+    try {
+        sink_(buffer_.data(), buffer_.size());
+    }
+    catch (...) {
+        // drop the block so the destructor does not hand it to a failing sink again
+        buffer_.clear();
+        throw;
+    }
+
+    bytesWritten_ += buffer_.size();
+    buffer_.clear();
+}
+
+void ResultExporter::append(const char* data, const std::size_t size) {
+    if (buffer_.size() + size > blockSize_) {
+        flush();
+
+        // values larger than a block go straight to the sink instead of growing the buffer
+        if (size >= blockSize_) {
+            sink_(data, size);
+            bytesWritten_ += size;
+            return;
+        }
+    }
+
+    buffer_.insert(buffer_.end(), data, data + size);
+}
+
+void ResultExporter::append(const char c) {
+    if (buffer_.size() + 1 > blockSize_) {
+        flush();
+    }
+
+    buffer_.push_back(c);
+}
+
+void ResultExporter::appendUInt32(const unsigned int value) {
+    char bytes[4];
+    for (auto ii = 0; ii < 4; ii++) {
+        bytes[ii] = static_cast<char>((value >> (8 * ii)) & 0xFF);
+    }
+    append(bytes, sizeof(bytes));
+}
+
+void ResultExporter::appendUInt64(const unsigned long long value) {
+    char bytes[8];
+    for (auto ii = 0; ii < 8; ii++) {
+        bytes[ii] = static_cast<char>((value >> (8 * ii)) & 0xFF);
+    }
+    append(bytes, sizeof(bytes));
+}
+
+void ResultExporter::appendHex(const unsigned char* data, const std::size_t size) {
+    static const char kDigits[] = "0123456789abcdef";
+
+    for (std::size_t ii = 0; ii < size; ii++) {
+        append(kDigits[data[ii] >> 4]);
+        append(kDigits[data[ii] & 0x0F]);
+    }
+}
+
+void ResultExporter::appendCsvField(const char* data, const std::size_t size) {
+    bool quote = false;
+    for (std::size_t ii = 0; ii < size && !quote; ii++) {
+        quote = data[ii] == ',' || data[ii] == '"' || data[ii] == '\r' || data[ii] == '\n';
+    }
+
+    if (!quote) {
+        append(data, size);
+        return;
+    }
+
+    append('"');
+    for (std::size_t ii = 0; ii < size; ii++) {
+        if (data[ii] == '"') {
+            append('"');
+        }
+        append(data[ii]);
+    }
+    append('"');
+}
+
+void ResultExporter::appendJsonString(const char* data, const std::size_t size) {
+    append('"');
+
+    char escaped[8];
+    for (std::size_t ii = 0; ii < size; ii++) {
+        auto length = jsonEscape(static_cast<unsigned char>(data[ii]), escaped);
+
+        if (length > 0) {
+            append(escaped, length);
+        }
+        else {
+            append(data[ii]);
+        }
+    }
+
+    append('"');
+}
+
+void ResultExporter::appendNumber(sqlite3_stmt* stmt, const int col) {
+    char number[32];
+    int size;
+
+    if (sqlite3_column_type(stmt, col) == SQLITE_INTEGER) {
+        size = std::snprintf(number, sizeof(number), "%lld", static_cast<long long>(sqlite3_column_int64(stmt, col)));
+    }
+    else {
+        auto real = sqlite3_column_double(stmt, col);
+
+        // JSON has no representation for inf and nan
+        if (format_ == JsonLines && (std::isnan(real) || std::isinf(real))) {
+            append("null", 4);
+            return;
+        }
+        size = std::snprintf(number, sizeof(number), "%.17g", real);
+    }
+
+    append(number, static_cast<std::size_t>(size));
+}
+
+} /* namespace sqlite */
@@ -0,0 +1,95 @@
+/*
+ * File:   SQLiteAsyncDatabase.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include "SQLiteAsyncDatabase.h"
+
+namespace sqlite {
+
+SQLiteAsyncDatabase::SQLiteAsyncDatabase(SQLiteDatabase& db)
+        : db_(db), stopping_(false), worker_(&SQLiteAsyncDatabase::run, this) {
+}
+
+SQLiteAsyncDatabase::SQLiteAsyncDatabase(SQLiteConnectionPool::Lease&& lease)
+        : lease_(new SQLiteConnectionPool::Lease(std::move(lease))),
+          db_(lease_->get()),
+          stopping_(false),
+          worker_(&SQLiteAsyncDatabase::run, this) {
+}
+
+SQLiteAsyncDatabase::~SQLiteAsyncDatabase() {
+    shutdown();
+}
+
+std::future<Cursor> SQLiteAsyncDatabase::queryAsync(const std::string& sql) {
+    return submit([sql](SQLiteDatabase& db) { return db.query(sql); });
+}
+
+std::future<void> SQLiteAsyncDatabase::execAsync(const std::string& sql) {
+    return submit([sql](SQLiteDatabase& db) { db.execQuery(sql); });
+}
+
+std::future<long long> SQLiteAsyncDatabase::insertAsync(const std::string& table,
+                                                        const std::vector<std::string>& columns,
+                                                        const std::vector<Value>& values) {
+    return submit([table, columns, values](SQLiteDatabase& db) { return db.insert(table, columns, values); });
+}
+
+void SQLiteAsyncDatabase::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+
+    queueChanged_.notify_one();
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+std::size_t SQLiteAsyncDatabase::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+void SQLiteAsyncDatabase::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (stopping_) {
+            throw SQLiteDatabaseException("Async database is shut down");
+        }
+
+        queue_.push_back(std::move(task));
+    }
+
+    queueChanged_.notify_one();
+}
+
+void SQLiteAsyncDatabase::run() {
+    for (;;) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            queueChanged_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+
+            // drain the queue before stopping
+            if (queue_.empty()) {
+                return;
+            }
+
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        // packaged_task stores any exception in the future
+        task();
+    }
+}
+
+} /* namespace sqlite */
@@ -0,0 +1,174 @@
+/*
+ * File:   SQLiteBackup.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include <SQLiteDatabase.h>
+#include "SQLiteBackup.h"
+
+#include <thread>
+
+namespace sqlite {
+
+const int SQLiteBackup::kDefaultPagesPerStep;
+const int SQLiteBackup::kDefaultPauseMs;
+
+SQLiteBackup::SQLiteBackup(SQLiteDatabase& destination, SQLiteDatabase& source, const std::string& destinationName,
+                           const std::string& sourceName)
+        : destinationDatabase_(&destination),
+          destination_(destination.db_), backup_(nullptr), done_(false), restarts_(0), copied_(0) {
+
+    if (!destination.isOpen() || !source.isOpen()) {
+        throw SQLiteDatabaseException("Backup requires open source and destination databases");
+    }
+
+    backup_ = sqlite3_backup_init(destination_, destinationName.c_str(), source.db_, sourceName.c_str());
+
+    // errors are reported on the destination connection
+    if (backup_ == nullptr) {
+        throw SQLiteDatabaseException("Error starting backup " + std::string(sqlite3_errmsg(destination_)));
+    }
+}
+
+SQLiteBackup::~SQLiteBackup() {
+    if (backup_ != nullptr) {
+        sqlite3_backup_finish(backup_);
+    }
+}
+
+bool SQLiteBackup::step(const int pages) {
+    if (done_) {
+        return true;
+    }
+
+    if (backup_ == nullptr) {
+        throw SQLiteDatabaseException("Backup is finished");
+    }
+
+    auto rc = sqlite3_backup_step(backup_, pages);
+
+    switch (rc) {
+        case SQLITE_DONE:
+            done_ = true;
+            contentsReplaced();
+            finish();
+            return true;
+        case SQLITE_OK: {
+            contentsReplaced();
+
+            // a write from another connection sends the backup back to the first page
+            auto copied = sqlite3_backup_pagecount(backup_) - sqlite3_backup_remaining(backup_);
+            if (pages > 0 && copied < copied_ + pages) {
+                restarts_++;
+            }
+            copied_ = copied;
+            return false;
+        }
+        case SQLITE_BUSY:
+        case SQLITE_LOCKED:
+            // try again on the next step
+            return false;
+        default: {
+            std::string errorMsg = "Error during backup " + std::string(sqlite3_errstr(rc));
+            sqlite3_backup_finish(backup_);
+            backup_ = nullptr;
+            throw SQLiteDatabaseException(errorMsg);
+        }
+    }
+}
+
+bool SQLiteBackup::run(const int pagesPerStep, const int pauseMs, const ProgressCallback& progress) {
+    while (!step(pagesPerStep)) {
+        if (progress && !progress(getRemaining(), getPageCount())) {
+            finish();
+            return false;
+        }
+
+        if (pauseMs > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(pauseMs));
+        }
+    }
+
+    if (progress) {
+        progress(0, getPageCount());
+    }
+
+    return true;
+}
+
+void SQLiteBackup::contentsReplaced() {
+    // the cache and the observer listen to the tracker, no tracker means neither is in use
+    if (destinationDatabase_->changes_) {
+        destinationDatabase_->changes_->notifyAllChanged();
+    }
+}
+
+void SQLiteBackup::finish() {
+    if (backup_ == nullptr) {
+        return;
+    }
+
+    // keep the final counts readable after the handle is gone
+    auto remaining = sqlite3_backup_remaining(backup_);
+    auto pageCount = sqlite3_backup_pagecount(backup_);
+
+    auto rc = sqlite3_backup_finish(backup_);
+    backup_ = nullptr;
+    copied_ = pageCount - remaining;
+
+    if (rc != SQLITE_OK) {
+        throw SQLiteDatabaseException("Error finishing backup " + std::string(sqlite3_errmsg(destination_)));
+    }
+}
+
+int SQLiteBackup::getRemaining() const {
+    if (backup_ == nullptr) {
+        return done_ ? 0 : -1;
+    }
+    return sqlite3_backup_remaining(backup_);
+}
+
+int SQLiteBackup::getPageCount() const {
+    if (backup_ == nullptr) {
+        return done_ ? copied_ : -1;
+    }
+    return sqlite3_backup_pagecount(backup_);
+}
+
+void SQLiteBackup::load(SQLiteDatabase& connection, const std::string& filename, const int pagesPerStep,
+                        const int pauseMs) {
+    SQLiteDatabase file;
+    file.open(filename, SQLITE_OPEN_READONLY);
+
+    try {
+        SQLiteBackup backup(connection, file);
+        backup.run(pagesPerStep, pauseMs);
+    }
+    catch (...) {
+        file.close();
+        throw;
+    }
+
+    file.close();
+}
+
+void SQLiteBackup::save(SQLiteDatabase& connection, const std::string& filename, const int pagesPerStep,
+                        const int pauseMs) {
+    SQLiteDatabase file;
+    file.open(filename, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+    try {
+        SQLiteBackup backup(file, connection);
+        backup.run(pagesPerStep, pauseMs);
+    }
+    catch (...) {
+        file.close();
+        throw;
+    }
+
+    file.close();
+}
+
+} /* namespace sqlite */
@@ -0,0 +1,216 @@
+/*
+ * File:   SQLiteConnectionPool.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include "SQLiteConnectionPool.h"
+
+#include <algorithm>
+
+namespace sqlite {
+
+const std::size_t SQLiteConnectionPool::kDefaultMaxReadConnections;
+
+SQLiteConnectionPool::Lease::Lease(SQLiteConnectionPool* pool, SQLiteDatabase* db, const bool writer)
+        : pool_(pool), db_(db), writer_(writer) {
+}
+
+SQLiteConnectionPool::Lease::Lease(Lease&& other) : pool_(other.pool_), db_(other.db_), writer_(other.writer_) {
+    other.pool_ = nullptr;
+    other.db_ = nullptr;
+}
+
+SQLiteConnectionPool::Lease& SQLiteConnectionPool::Lease::operator=(Lease&& other) {
+    if (this != &other) {
+        release();
+
+        pool_ = other.pool_;
+        db_ = other.db_;
+        writer_ = other.writer_;
+
+        other.pool_ = nullptr;
+        other.db_ = nullptr;
+    }
+
+    return *this;
+}
+
+SQLiteConnectionPool::Lease::~Lease() {
+    release();
+}
+
+void SQLiteConnectionPool::Lease::release() {
+    if (pool_ != nullptr) {
+        pool_->releaseConnection(db_, writer_);
+        pool_ = nullptr;
+        db_ = nullptr;
+    }
+}
+
+SQLiteConnectionPool::SQLiteConnectionPool(const std::string& filename, const std::size_t maxReadConnections,
+                                           const OpenOptions& options)
+        : filename_(filename),
+          maxReadConnections_(maxReadConnections),
+          options_(options),
+          writerLeased_(false),
+          openingReaders_(0),
+          open_(false) {
+    if (maxReadConnections_ == 0) {
+        throw SQLiteDatabaseException("Connection pool needs at least one read connection");
+    }
+
+    // WAL lets the readers run while the writer commits, the mode is stored in the database file
+    options_.journalMode = "WAL";
+}
+
+SQLiteConnectionPool::~SQLiteConnectionPool() {
+    // destructors must not throw, a connection still busy with a leased statement is left to the OS
+    try {
+        close();
+    }
+    catch (...) {
+    }
+}
+
+void SQLiteConnectionPool::open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (open_) {
+        return;
+    }
+
+    if (writer_) {
+        throw SQLiteDatabaseException("Writer connection is still leased");
+    }
+
+    // the writer creates the file, readers can only open it once it exists
+    std::unique_ptr<SQLiteDatabase> writer(new SQLiteDatabase());
+    writer->open(filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, options_);
+
+    writer_ = std::move(writer);
+    writerLeased_ = false;
+    open_ = true;
+}
+
+void SQLiteConnectionPool::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    open_ = false;
+
+    // close idle readers, leased readers are closed by releaseConnection
+    for (auto db : idleReaders_) {
+        db->close();
+        readers_.erase(std::find_if(readers_.begin(), readers_.end(),
+                                    [db](const std::unique_ptr<SQLiteDatabase>& reader) { return reader.get() == db; }));
+    }
+    idleReaders_.clear();
+
+    if (writer_ && !writerLeased_) {
+        writer_->close();
+        writer_.reset();
+    }
+
+    // wake up waiting threads so they see the pool is closed
+    readerAvailable_.notify_all();
+    writerAvailable_.notify_all();
+}
+
+bool SQLiteConnectionPool::isOpen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+}
+
+std::size_t SQLiteConnectionPool::openReadConnections() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return readers_.size();
+}
+
+SQLiteConnectionPool::Lease SQLiteConnectionPool::acquireReader() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for (;;) {
+        if (!open_) {
+            throw SQLiteDatabaseException("Connection pool is not open");
+        }
+
+        if (!idleReaders_.empty()) {
+            auto db = idleReaders_.back();
+            idleReaders_.pop_back();
+            return Lease(this, db, false);
+        }
+
+        if (readers_.size() + openingReaders_ < maxReadConnections_) {
+            break;
+        }
+
+        readerAvailable_.wait(lock);
+    }
+
+    // open a new reader without holding the lock so other leases are not blocked on file I/O
+    openingReaders_++;
+    lock.unlock();
+
+    std::unique_ptr<SQLiteDatabase> reader(new SQLiteDatabase());
+
+    try {
+        reader->open(filename_, SQLITE_OPEN_READONLY, options_);
+    }
+    catch (...) {
+        lock.lock();
+        openingReaders_--;
+        readerAvailable_.notify_one();
+        throw;
+    }
+
+    lock.lock();
+    openingReaders_--;
+
+    auto db = reader.get();
+    readers_.push_back(std::move(reader));
+
+    return Lease(this, db, false);
+}
+
+SQLiteConnectionPool::Lease SQLiteConnectionPool::acquireWriter() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    writerAvailable_.wait(lock, [this]() { return !open_ || !writerLeased_; });
+
+    if (!open_) {
+        throw SQLiteDatabaseException("Connection pool is not open");
+    }
+
+    writerLeased_ = true;
+
+    return Lease(this, writer_.get(), true);
+}
+
+void SQLiteConnectionPool::releaseConnection(SQLiteDatabase* db, const bool writer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (writer) {
+        writerLeased_ = false;
+
+        if (!open_) {
+            writer_->close();
+            writer_.reset();
+        }
+
+        writerAvailable_.notify_one();
+        return;
+    }
+
+    if (open_) {
+        idleReaders_.push_back(db);
+        readerAvailable_.notify_one();
+        return;
+    }
+
+    db->close();
+    readers_.erase(std::find_if(readers_.begin(), readers_.end(),
+                                [db](const std::unique_ptr<SQLiteDatabase>& reader) { return reader.get() == db; }));
+}
+
+} /* namespace sqlite */
@@ -6,6 +6,7 @@
  */
 
 #include "SQLiteDatabase.h"
+#include "Transaction.h"
 
 #include <algorithm>
 
@@ -23,12 +24,74 @@ inline bool fexists(const std::string& filename){
     }
 };
 
+// Feeds SQLITE_TRACE_PROFILE events into the connection's StatementStats
+int profileCallback(unsigned type, void* context, void* p, void* x) {
+    if (type == SQLITE_TRACE_PROFILE) {
+        auto stmt = static_cast<sqlite3_stmt*>(p);
+        auto nanoseconds = *static_cast<sqlite3_int64*>(x);
+
+        // sqlite3_changes still holds the count of the last write when a read only statement finishes
+        auto changes = sqlite3_stmt_readonly(stmt) ? 0 : sqlite3_changes(sqlite3_db_handle(stmt));
+
+        static_cast<StatementStats*>(context)->recordExecution(sqlite3_sql(stmt), nanoseconds, changes);
+    }
+
+    return 0;
+}
+
+// Turns a plain path into a file: URI, percent encoding the characters that end the path part or start an escape
+std::string toFileUri(const std::string& path) {
+    static const char kHex[] = "0123456789ABCDEF";
+
+    std::string uri = "file:";
+    uri.reserve(path.size() + 5);
+
+    for (unsigned char c : path) {
+        if (c == '?' || c == '#' || c == '%') {
+            uri += '%';
+            uri += kHex[c >> 4];
+            uri += kHex[c & 0xF];
+        }
+        else {
+            uri += static_cast<char>(c);
+        }
+    }
+
+    return uri;
+}
+
 } /* namespace sqlite::utility */
 
-SQLiteDatabase::SQLiteDatabase() : db_(nullptr), open_(false) { }
+const std::size_t SQLiteDatabase::kDefaultInsertBatchSize;
+const long long OpenOptions::kNotSet;
+
+SQLiteDatabase::SQLiteDatabase()
+        : db_(nullptr), open_(false), statements_(std::make_shared<StatementCache>()),
+          resultListener_(-1), transactions_(std::make_shared<TransactionStatements>()) { }
 
 void SQLiteDatabase::open(const std::string& filename, const int flags) {
+    open(filename, flags, OpenOptions());
+}
+
+void SQLiteDatabase::open(const std::string& filename, const int flags, const OpenOptions& options) {
 
+    auto path = filename;
+    auto openFlags = flags;
+
+    if (options.uri) {
+        openFlags |= SQLITE_OPEN_URI;
+    }
+
+    // immutable is only available as a URI parameter and implies read only
+    if (options.immutable) {
+        openFlags = (openFlags & ~(SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE)) | SQLITE_OPEN_READONLY | SQLITE_OPEN_URI;
+
+        if (path.compare(0, 5, "file:") != 0) {
+            path = utility::toFileUri(path);
+        }
+        path += (path.find('?') == std::string::npos ? "?" : "&");
+        path += "immutable=1";
+    }
 
     // If trying to open a read only database connection make sure it is created and if not create it
     if(!utility::fexists(filename) && flags == SQLITE_OPEN_READONLY){
@@ -42,7 +105,7 @@ void SQLiteDatabase::open(const std::string& filename, const int flags) {
 
     }
 
-    auto rc = sqlite3_open_v2(filename.c_str(), &db_, flags, nullptr);
+    auto rc = sqlite3_open_v2(path.c_str(), &db_, openFlags, nullptr);
 
     if (rc) {
         std::string errorMsg = "Can't open database: " + std::string(sqlite3_errstr(rc));
@@ -51,9 +114,74 @@ void SQLiteDatabase::open(const std::string& filename, const int flags) {
     }
 
     open_ = true;
+
+    installHooks();
+
+    try {
+        applyOptions(options, (openFlags & SQLITE_OPEN_READONLY) != 0);
+    }
+    catch (...) {
+        close();
+        throw;
+    }
+}
+
+void SQLiteDatabase::applyOptions(const OpenOptions& options, const bool readOnly) {
+    std::string sql;
+
+    // page_size has to come before journal_mode, the page size of a WAL database can't change
+    if (!readOnly && options.pageSize != OpenOptions::kNotSet) {
+        sql += "PRAGMA page_size = " + std::to_string(options.pageSize) + ";";
+    }
+
+    if (!readOnly && !options.journalMode.empty()) {
+        sql += "PRAGMA journal_mode = " + options.journalMode + ";";
+    }
+
+    if (!options.synchronous.empty()) {
+        sql += "PRAGMA synchronous = " + options.synchronous + ";";
+    }
+
+    if (options.cacheSize != OpenOptions::kNotSet) {
+        sql += "PRAGMA cache_size = " + std::to_string(options.cacheSize) + ";";
+    }
+
+    if (options.mmapSize != OpenOptions::kNotSet) {
+        sql += "PRAGMA mmap_size = " + std::to_string(options.mmapSize) + ";";
+    }
+
+    if (!options.tempStore.empty()) {
+        sql += "PRAGMA temp_store = " + options.tempStore + ";";
+    }
+
+    if (options.busyTimeout != OpenOptions::kNotSet) {
+        setBusyPolicy(BusyPolicy::timeout(static_cast<int>(options.busyTimeout)));
+    }
+
+    // one round trip for all of the pragmas
+    if (!sql.empty()) {
+        execQuery(sql);
+    }
 }
 
 void SQLiteDatabase::close() {
+    // the dispatcher thread and observed statements use the connection
+    if (observer_) {
+        observer_->stop();
+        observer_.reset();
+    }
+
+    // cached statements keep the connection busy, finalize them first
+    statements_->clear();
+    transactions_->clear();
+
+    // the hooks go away with the connection
+    changes_.reset();
+    resultListener_ = -1;
+    if (results_) {
+        results_->clear();
+    }
+
     auto rc = sqlite3_close(db_);
 
     if (rc) {
@@ -66,27 +194,15 @@ void SQLiteDatabase::close() {
 }
 
 int SQLiteDatabase::getVersion() {
-    sqlite3_stmt *pStmt;
+    static const std::string sql = "PRAGMA user_version;";
 
-    const std::string sql = "PRAGMA user_version;";
+    ScopedStatement stmt(*statements_, sql, prepareCached(sql, "Failed to prepare statement "));
 
-    auto rc = sqlite3_prepare_v2(db_, sql.c_str(), sql.size() + 1, &pStmt, nullptr);
-
-    if (rc == SQLITE_OK) {
-        if (sqlite3_step(pStmt) == SQLITE_ROW) {
-            int version = sqlite3_column_int(pStmt, 0);
-            sqlite3_finalize(pStmt);
-            return version;
-        }
-        else {
-            sqlite3_finalize(pStmt);
-            throw SQLiteDatabaseException("Failed to query database version " + getSQLite3ErrorMessage());
-        }
-    }
-    else {
-        sqlite3_finalize(pStmt);
-        throw SQLiteDatabaseException("Failed to prepare statement " + getSQLite3ErrorMessage());
+    if (sqlite3_step(stmt.get()) != SQLITE_ROW) {
+        throw SQLiteDatabaseException("Failed to query database version " + getSQLite3ErrorMessage());
     }
+
+    return sqlite3_column_int(stmt.get(), 0);
 }
 
 void SQLiteDatabase::setVersion(const int version) {
@@ -117,57 +233,267 @@ void SQLiteDatabase::execQuery(const std::string& sql){
 }
 
 Cursor SQLiteDatabase::query(const std::string& sql) {
+    return queryCached(sql, std::vector<Value>());
+}
 
-    Cursor c;
+Cursor SQLiteDatabase::rawQuery(const std::string& sql, const std::vector<Value>& selectionArgs) {
+    return queryCached(sql, selectionArgs);
+}
 
-    sqlite3_stmt *pStmt;
+Cursor SQLiteDatabase::queryCached(const std::string& sql, const std::vector<Value>& args) {
+    // inside a transaction results can include uncommitted writes, don't share them
+    auto cacheable = results_ && sqlite3_get_autocommit(db_);
 
-    auto rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &pStmt, nullptr);
+    std::string key;
+    unsigned long long generation = 0;
+
+    if (cacheable) {
+        key = ResultCache::makeKey(sql, args);
+
+        auto cached = results_->get(key);
+        if (cached) {
+            return *cached;
+        }
+
+        generation = results_->generation();
+    }
+
+    ScopedStatement stmt(*statements_, sql, prepareCached(sql, "Failed to query database"));
+
+    bindValues(stmt.get(), args, 1);
+
+    auto c = buildCursor(stmt.get());
+
+    // only results made of table rows are invalidated by table changes, see TableChangeTracker::isDeterministic
+    if (cacheable && sqlite3_stmt_readonly(stmt.get()) && getChangeTracker().isDeterministic(sql)) {
+        results_->put(key, c, getChangeTracker().tablesRead(sql), generation);
+    }
+
+    return c;
+}
+
+WindowedCursor SQLiteDatabase::queryWindowed(const std::string& table, const std::vector<std::string>& columns,
+                                             const std::string& selection, const std::vector<Value>& selectionArgs,
+                                             const std::size_t windowSize) {
+    return WindowedCursor(*this, table, columns, selection, selectionArgs, windowSize);
+}
+
+long long SQLiteDatabase::exportQuery(const std::string& sql, const std::vector<Value>& args,
+                                     ResultExporter& exporter) {
+    ScopedStatement stmt(*statements_, sql, prepareCached(sql, "Error preparing statment"));
+
+    bindValues(stmt.get(), args, 1);
+
+    exporter.writeHeader(stmt.get());
+
+    long long rows = 0;
+    int rc;
+
+    while ((rc = sqlite3_step(stmt.get())) == SQLITE_ROW) {
+        exporter.writeRow(stmt.get());
+        rows++;
+    }
+
+    checkDone(rc);
+    exporter.flush();
+
+    if (stats_) {
+        stats_->recordResult(sqlite3_sql(stmt.get()), rows, 0);
+    }
+
+    return rows;
+}
+
+BlobStream SQLiteDatabase::openBlob(const std::string& table, const std::string& column, const long long rowid,
+                                    const bool writable, const std::string& database) {
+    sqlite3_blob* blob = nullptr;
+
+    auto rc = sqlite3_blob_open(db_, database.c_str(), table.c_str(), column.c_str(), rowid, writable ? 1 : 0, &blob);
 
-    // If the sql executed return else throw exception
     if (rc != SQLITE_OK) {
-        throw SQLiteDatabaseException("Failed to query database" + getSQLite3ErrorMessage());
+        sqlite3_blob_close(blob);
+        throw SQLiteDatabaseException("Error opening blob " + getSQLite3ErrorMessage());
     }
 
+    return BlobStream(db_, blob);
+}
+
+Cursor SQLiteDatabase::buildCursor(sqlite3_stmt* stmt) {
+    Cursor c;
+
     // columns in the returned result set
-    int cols = 0;
+    auto cols = sqlite3_column_count(stmt);
+    for (auto col = 0; col < cols; col++) {
+        c.addColumn(std::string(sqlite3_column_name(stmt, col)));
+    }
 
     // Step through all rows in the result set
     // building the cursor result set
-    while (sqlite3_step(pStmt) == SQLITE_ROW) {
-        static bool firstRow = true;
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        c.addRow(stmt);
+    }
 
-        if (firstRow) {
-            cols = sqlite3_column_count(pStmt);
+    // a failing sql function or constraint ends the loop early, don't return a partial result
+    checkDone(rc);
 
-            for (auto col = 0; col < cols; col++) {
-                c.columnNames.push_back(std::string(sqlite3_column_name(pStmt, col)));
-                c.columnNamesIndexMap[c.columnNames.back()] = col;
-            }
+    if (stats_) {
+        stats_->recordResult(sqlite3_sql(stmt), c.getCount(), c.getByteSize());
+    }
 
-            firstRow = false;
-        }
+    return c;
+}
+
+sqlite3_stmt* SQLiteDatabase::prepareCached(const std::string& sql, const std::string& errorMsg) {
+    sqlite3_stmt* stmt = nullptr;
 
-        std::vector<std::string> row;
+    int rc;
 
-        for (auto col = 0; col < cols; col++) {
-            row.push_back(getStdString(sqlite3_column_text(pStmt, col)));
+    if (stats_) {
+        auto start = std::chrono::steady_clock::now();
+        bool cacheHit = false;
+
+        rc = statements_->acquire(db_, sql, &stmt, &cacheHit);
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        stats_->recordPrepare(sql, elapsed.count(), cacheHit);
+    }
+    else {
+        rc = statements_->acquire(db_, sql, &stmt);
+    }
+
+    if (rc != SQLITE_OK) {
+        throw SQLiteDatabaseException(errorMsg + getSQLite3ErrorMessage());
+    }
+
+    return stmt;
+}
+
+void SQLiteDatabase::setStatsEnabled(const bool enabled) {
+    if (enabled == static_cast<bool>(stats_)) {
+        return;
+    }
+
+    if (enabled) {
+        stats_ = std::make_shared<StatementStats>();
+
+        if (open_) {
+            installTrace();
+        }
+    }
+    else {
+        // unhook before the collector can go away
+        if (open_) {
+            sqlite3_trace_v2(db_, 0, nullptr, nullptr);
+        }
+        stats_.reset();
+    }
+}
+
+void SQLiteDatabase::setMaxResultCacheSize(const std::size_t maxBytes) {
+    if (maxBytes == 0) {
+        if (changes_ && resultListener_ >= 0) {
+            changes_->removeListener(resultListener_);
         }
+        resultListener_ = -1;
+        results_.reset();
+        return;
+    }
 
-        c.addRow(row);
+    if (results_) {
+        results_->setMaxBytes(maxBytes);
+        return;
     }
 
-    sqlite3_finalize(pStmt);
+    results_ = std::make_shared<ResultCache>(maxBytes);
 
-    return c;
+    if (open_) {
+        installHooks();
+    }
 }
 
-std::string SQLiteDatabase::getStdString(const unsigned char *text) {
-    if (text == nullptr) {
-        return "NULL";
+void SQLiteDatabase::installHooks() {
+    if (stats_) {
+        installTrace();
     }
 
-    return std::string(reinterpret_cast<const char *>(text));
+    if (busy_) {
+        busy_->install(db_);
+    }
+
+    if (results_ && resultListener_ < 0) {
+        std::weak_ptr<ResultCache> cache = results_;
+
+        resultListener_ = getChangeTracker().addListener([cache](const std::set<std::string>& tables, bool allTables) {
+            auto results = cache.lock();
+            if (!results) {
+                return;
+            }
+            if (allTables) {
+                results->clear();
+            }
+            else {
+                results->invalidate(tables);
+            }
+        });
+    }
+}
+
+TableChangeTracker& SQLiteDatabase::getChangeTracker() {
+    if (!changes_) {
+        changes_ = std::make_shared<TableChangeTracker>(db_);
+
+        // cached statements were prepared without the tracker's authorizer
+        statements_->clear();
+    }
+
+    return *changes_;
+}
+
+void SQLiteDatabase::setBusyPolicy(const BusyPolicy& policy) {
+    auto handler = std::make_shared<BusyHandler>(policy);
+
+    // install before the old handler goes away, a statement may be waiting in it
+    if (open_) {
+        handler->install(db_);
+    }
+
+    busy_ = handler;
+}
+
+LockWaitStats SQLiteDatabase::getLockWaitStats() const {
+    return busy_ ? busy_->stats() : LockWaitStats();
+}
+
+void SQLiteDatabase::resetLockWaitStats() {
+    if (busy_) {
+        busy_->resetStats();
+    }
+}
+
+QuerySubscription SQLiteDatabase::observe(const std::string& sql, const std::vector<Value>& args,
+                                          const QueryObserver::Callback& callback) {
+    return getQueryObserver()->subscribe(sql, args, callback);
+}
+
+std::shared_ptr<QueryObserver> SQLiteDatabase::getQueryObserver() {
+    if (!open_) {
+        throw SQLiteDatabaseException("Can't observe queries database connection not open");
+    }
+
+    if (!observer_) {
+        observer_ = std::make_shared<QueryObserver>(db_, getChangeTracker());
+    }
+
+    return observer_;
+}
+
+void SQLiteDatabase::installTrace() {
+    sqlite3_trace_v2(db_, SQLITE_TRACE_PROFILE, utility::profileCallback, stats_.get());
+}
+
+void SQLiteDatabase::setMaxSqlCacheSize(const std::size_t cacheSize) {
+    statements_->setCapacity(cacheSize);
 }
 
 SQLiteDatabase::~SQLiteDatabase() {
@@ -182,106 +508,211 @@ std::string SQLiteDatabase::getSQLite3ErrorMessage() {
     return std::string(sqlite3_errmsg(db_));
 }
 
-void SQLiteDatabase::beginTransaction() {
-    execQuery("BEGIN");
+void SQLiteDatabase::beginTransaction(const TransactionMode mode) {
+    switch (mode) {
+        case Immediate:
+            execTransaction(TransactionStatements::BeginImmediate);
+            break;
+        case Exclusive:
+            execTransaction(TransactionStatements::BeginExclusive);
+            break;
+        default:
+            execTransaction(TransactionStatements::Begin);
+            break;
+    }
 }
 
 void SQLiteDatabase::endTransaction() {
-    execQuery("COMMIT");
+    execTransaction(TransactionStatements::Commit);
 }
 
 void SQLiteDatabase::rollback() {
-    execQuery("ROLLBACK");
+    execTransaction(TransactionStatements::Rollback);
 }
 
-bool SQLiteDatabase::isOpen() {
-    return open_;
+bool SQLiteDatabase::inTransaction() {
+    return open_ && !sqlite3_get_autocommit(db_);
 }
 
-Cursor SQLiteDatabase::query(const std::string& table, const std::vector<std::string>& columns,
-                             const std::string& selection, const std::vector<std::string>& selectionArgs,
-                             const std::string& groupBy, const std::string& orderBy, const std::string& limit){
-    return query(false, table, columns, selection, selectionArgs, groupBy, orderBy, limit);
+void SQLiteDatabase::savepoint() {
+    execTransaction(TransactionStatements::Savepoint);
 }
 
-Cursor SQLiteDatabase::query(bool distinct, const std::string& table, const std::vector<std::string>& columns,
-                             const std::string& selection, const std::vector<std::string>& selectionArgs,
-                             const std::string& groupBy, const std::string& orderBy, const std::string& limit) {
-    std::string sql = "SELECT ";
+void SQLiteDatabase::releaseSavepoint() {
+    execTransaction(TransactionStatements::Release);
+}
+
+void SQLiteDatabase::rollbackToSavepoint() {
+    // ROLLBACK TO keeps the savepoint open, release it so it ends like a committed one
+    execTransaction(TransactionStatements::RollbackTo);
+    execTransaction(TransactionStatements::Release);
+}
 
-    if(distinct){
-        sql += "DISTINCT ";
+void SQLiteDatabase::execTransaction(const int kind) {
+    if (!open_) {
+        throw SQLiteDatabaseException("Can't execute query database connection not open");
     }
 
-    if(columns.size() == 0){
-        sql += "* ";
-    }else{
-        // add return columns
-        for(auto ii = 0; ii < columns.size(); ii++){
-            sql += columns[ii] + (ii < columns.size() - 1 ? ", " : " ");
+    transactions_->exec(db_, static_cast<TransactionStatements::Kind>(kind));
+}
+
+void SQLiteDatabase::registerFunction(const std::string& name, const int argumentCount, const int flags,
+                                      void* userData, void (*call)(sqlite3_context*, int, sqlite3_value**),
+                                      void (*step)(sqlite3_context*, int, sqlite3_value**),
+                                      void (*final)(sqlite3_context*), void (*value)(sqlite3_context*),
+                                      void (*inverse)(sqlite3_context*, int, sqlite3_value**),
+                                      void (*destroy)(void*)) {
+    if (!open_) {
+        if (destroy != nullptr) {
+            destroy(userData);
         }
+        throw SQLiteDatabaseException("Can't create function database connection not open");
     }
 
-    // Add table
-    sql += "FROM " + table;
+    int rc;
 
-    // Add where clause if needed
-    if(!selection.empty()){
-        sql += " WHERE ";
-        sql += selection;
+    // both calls hand userData to destroy if they fail
+    if (inverse != nullptr) {
+        rc = sqlite3_create_window_function(db_, name.c_str(), argumentCount, SQLITE_UTF8 | flags, userData, step,
+                                            final, value, inverse, destroy);
+    }
+    else {
+        rc = sqlite3_create_function_v2(db_, name.c_str(), argumentCount, SQLITE_UTF8 | flags, userData, call, step,
+                                        final, destroy);
     }
 
-    // Add where clause if needed
-    if(!groupBy.empty()){
-        sql += " GROUP BY " + groupBy;
+    if (rc != SQLITE_OK) {
+        throw SQLiteDatabaseException("Error creating function " + name + " " + getSQLite3ErrorMessage());
     }
 
-    // Add order by clause if needed
-    if(!orderBy.empty()){
-        sql += " ORDER BY " + orderBy;
+    // results of a replaced function are stale, results of a volatile one must never be cached
+    if (results_) {
+        results_->clear();
+    }
+    if ((flags & Deterministic) == 0) {
+        getChangeTracker().addVolatileFunction(name);
     }
+}
 
-    // Add limit clause if needed
-    if(!limit.empty()){
-        sql += " LIMIT " + limit;
+void SQLiteDatabase::createVirtualTable(const std::string& name, VirtualTableBase& table) {
+    if (!open_) {
+        throw SQLiteDatabaseException("Can't create virtual table database connection not open");
     }
 
-    sqlite3_stmt *stmt;
+    if (table.getSchema().back() != ')') {
+        throw SQLiteDatabaseException("Virtual table " + name + " has no columns");
+    }
 
-    auto rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
+    // one module per table, the module's client data is the table
+    auto module = "cppqlite_" + name;
+    if (sqlite3_create_module_v2(db_, module.c_str(), VirtualTableBase::module(), &table, nullptr) != SQLITE_OK) {
+        throw SQLiteDatabaseException("Error creating module " + module + " " + getSQLite3ErrorMessage());
+    }
 
-    // Bind arguments
-    for(auto ii = 0; ii < selectionArgs.size(); ii++) {
-        sqlite3_bind_text(stmt, ii + 1, selectionArgs[ii].c_str(), -1, SQLITE_TRANSIENT);
+    // temp keeps the table out of the database file, other connections don't have the module
+    execQuery("CREATE VIRTUAL TABLE temp." + name + " USING " + module);
+
+    // the range changes without the update hook seeing it, results reading it must never be cached
+    getChangeTracker().addVolatileTable(name);
+}
+
+BoundStatement SQLiteDatabase::prepare(const std::string& sql) {
+    if (!open_) {
+        throw SQLiteDatabaseException("Can't prepare statement database connection not open");
     }
 
-    if(rc){
+    sqlite3_stmt* stmt = nullptr;
+
+    auto rc = sqlite3_prepare_v2(db_, sql.c_str(), static_cast<int>(sql.size()), &stmt, nullptr);
+
+    if (rc != SQLITE_OK) {
         sqlite3_finalize(stmt);
-        throw SQLiteDatabaseException("Error preparing statment" + getSQLite3ErrorMessage());
+        throw SQLiteDatabaseException("Error preparing statement " + getSQLite3ErrorMessage());
     }
 
-    Cursor c;
-    auto cols = sqlite3_column_count(stmt);
-    for (auto col = 0; col < cols; col++) {
-        c.columnNames.push_back(std::string(sqlite3_column_name(stmt, col)));
-        c.columnNamesIndexMap[c.columnNames.back()] = col;
+    return BoundStatement(stmt);
+}
+
+BoundStatement SQLiteDatabase::prepareQuery(bool distinct, const std::string& table,
+                                            const std::vector<std::string>& columns, const std::string& selection,
+                                            const std::string& groupBy, const std::string& orderBy,
+                                            const std::string& limit) {
+    return prepare(SqlBuilder::select(distinct, table, columns, selection, groupBy, orderBy, limit));
+}
+
+BoundStatement SQLiteDatabase::prepareInsert(const std::string& table, const std::vector<std::string>& columns) {
+    if (columns.empty()) {
+        throw SQLiteDatabaseException("columns vector must has at least one item");
     }
 
-    // Step through all rows in the result set
-    // building the cursor result set
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-        std::vector<std::string> row;
+    return prepare(SqlBuilder::insert(table, columns));
+}
 
-        for (auto col = 0; col < cols; col++) {
-            row.push_back(getStdString(sqlite3_column_text(stmt, col)));
-        }
+BoundStatement SQLiteDatabase::prepareUpdate(const std::string& table, const std::vector<std::string>& columns,
+                                             const std::string& selection) {
+    if (columns.empty()) {
+        throw SQLiteDatabaseException("columns vector must has at least one item");
+    }
 
-        c.addRow(row);
+    return prepare(SqlBuilder::update(table, columns, selection));
+}
+
+BoundStatement SQLiteDatabase::prepareRemove(const std::string& table, const std::string& selection) {
+    if (selection.empty()) {
+        throw SQLiteDatabaseException("selection must has at least one column name");
     }
 
-    sqlite3_finalize(stmt);
+    return prepare(SqlBuilder::remove(table, selection));
+}
 
-    return c;
+bool SQLiteDatabase::isOpen() {
+    return open_;
+}
+
+Cursor SQLiteDatabase::query(const std::string& table, const std::vector<std::string>& columns,
+                             const std::string& selection, const std::vector<std::string>& selectionArgs,
+                             const std::string& groupBy, const std::string& orderBy, const std::string& limit){
+    return query(false, table, columns, selection, selectionArgs, groupBy, orderBy, limit);
+}
+
+Cursor SQLiteDatabase::query(bool distinct, const std::string& table, const std::vector<std::string>& columns,
+                             const std::string& selection, const std::vector<std::string>& selectionArgs,
+                             const std::string& groupBy, const std::string& orderBy, const std::string& limit) {
+    auto sql = SqlBuilder::select(distinct, table, columns, selection, groupBy, orderBy, limit);
+
+    if (results_) {
+        // string arguments bind as text, same as below
+        return queryCached(sql, std::vector<Value>(selectionArgs.begin(), selectionArgs.end()));
+    }
+
+    ScopedStatement stmt(*statements_, sql, prepareCached(sql, "Error preparing statment"));
+
+    // Bind arguments
+    for(auto ii = 0; ii < selectionArgs.size(); ii++) {
+        sqlite3_bind_text(stmt.get(), ii + 1, selectionArgs[ii].c_str(), -1, SQLITE_TRANSIENT);
+    }
+
+    return buildCursor(stmt.get());
+}
+
+StreamingCursor SQLiteDatabase::queryStreaming(bool distinct, const std::string& table,
+                                               const std::vector<std::string>& columns, const std::string& selection,
+                                               const std::vector<std::string>& selectionArgs, const std::string& groupBy,
+                                               const std::string& orderBy, const std::string& limit) {
+    return queryStreaming(SqlBuilder::select(distinct, table, columns, selection, groupBy, orderBy, limit),
+                          selectionArgs);
+}
+
+StreamingCursor SQLiteDatabase::queryStreaming(const std::string& sql, const std::vector<std::string>& selectionArgs) {
+    auto stmt = prepareCached(sql, "Error preparing statment");
+
+    // Bind arguments
+    for(auto ii = 0; ii < selectionArgs.size(); ii++) {
+        sqlite3_bind_text(stmt, ii + 1, selectionArgs[ii].c_str(), -1, SQLITE_TRANSIENT);
+    }
+
+    // the cursor owns the statement until it is exhausted or destroyed
+    return StreamingCursor(statements_, sql, stmt);
 }
 
 int SQLiteDatabase::insert(const std::string& table, const std::vector<std::string>& columns, const std::vector<std::string>& values,
@@ -321,31 +752,22 @@ int SQLiteDatabase::insert(const std::string& table, const std::vector<std::stri
         sql += selection;
     }
 
-    sqlite3_stmt *stmt;
-
-    auto rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
+    ScopedStatement stmt(*statements_, sql, prepareCached(sql, "Error preparing statement "));
 
     // Bind arguments
     for(auto ii = 0; ii < selectionArgs.size(); ii++) {
-        sqlite3_bind_text(stmt, ii + 1, selectionArgs[ii].c_str(), -1, SQLITE_TRANSIENT);
-    }
-
-    if(rc){
-        sqlite3_finalize(stmt);
-        throw SQLiteDatabaseException("Error preparing statement " + getSQLite3ErrorMessage());
+        sqlite3_bind_text(stmt.get(), ii + 1, selectionArgs[ii].c_str(), -1, SQLITE_TRANSIENT);
     }
 
     // Step through all rows in the result set
     // building the cursor result set
-    if(sqlite3_step(stmt) != SQLITE_DONE){
+    if(sqlite3_step(stmt.get()) != SQLITE_DONE){
         throw SQLiteDatabaseException("Error executing insert statement " + getSQLite3ErrorMessage());
     }
 
     // get the inserted rowid
     result = sqlite3_last_insert_rowid(db_);
 
-    sqlite3_finalize(stmt);
-
     return result;
 }
 
@@ -383,31 +805,22 @@ int SQLiteDatabase::update(const std::string& table, const std::vector<std::stri
         sql += selection;
     }
 
-    sqlite3_stmt *stmt;
-
-    auto rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
+    ScopedStatement stmt(*statements_, sql, prepareCached(sql, "Error preparing update statement "));
 
     // Bind arguments
     for(auto ii = 0; ii < selectionArgs.size(); ii++) {
-        sqlite3_bind_text(stmt, ii + 1, selectionArgs[ii].c_str(), -1, SQLITE_TRANSIENT);
-    }
-
-    if(rc){
-        sqlite3_finalize(stmt);
-        throw SQLiteDatabaseException("Error preparing update statement " + getSQLite3ErrorMessage());
+        sqlite3_bind_text(stmt.get(), ii + 1, selectionArgs[ii].c_str(), -1, SQLITE_TRANSIENT);
     }
 
     // Step through all rows in the result set
     // building the cursor result set
-    if(sqlite3_step(stmt) != SQLITE_DONE){
+    if(sqlite3_step(stmt.get()) != SQLITE_DONE){
         throw SQLiteDatabaseException("Error executing update statement " + getSQLite3ErrorMessage());
     }
 
     // Get number of rows modified
     result = sqlite3_changes(db_);
 
-    sqlite3_finalize(stmt);
-
     return result;
 }
 
@@ -430,31 +843,197 @@ int SQLiteDatabase::remove(const std::string& table, const std::string& selectio
     sql += " WHERE ";
     sql += selection;
 
-    sqlite3_stmt *stmt;
-
-    auto rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
+    ScopedStatement stmt(*statements_, sql, prepareCached(sql, "Error preparing update statement "));
 
     // Bind arguments
     for(auto ii = 0; ii < selectionArgs.size(); ii++) {
-        sqlite3_bind_text(stmt, ii + 1, selectionArgs[ii].c_str(), -1, SQLITE_TRANSIENT);
-    }
-
-    if(rc){
-      sqlite3_finalize(stmt);
-      throw SQLiteDatabaseException("Error preparing update statement " + getSQLite3ErrorMessage());
+        sqlite3_bind_text(stmt.get(), ii + 1, selectionArgs[ii].c_str(), -1, SQLITE_TRANSIENT);
     }
 
     // Step through all rows in the result set
     // building the cursor result set
-    if(sqlite3_step(stmt) != SQLITE_DONE){
+    if(sqlite3_step(stmt.get()) != SQLITE_DONE){
       throw SQLiteDatabaseException("Error executing update statement " + getSQLite3ErrorMessage());
     }
 
     // Get number of rows modified
     result = sqlite3_changes(db_);
 
-    sqlite3_finalize(stmt);
-
     return result;
 }
-} /* namespace sqlite */
\ No newline at end of file
+
+long long SQLiteDatabase::insert(const std::string& table, const std::vector<std::string>& columns,
+                                 const std::vector<Value>& values) {
+    if(columns.size() == 0){
+        throw SQLiteDatabaseException("columns vector must has at least one item");
+    }
+
+    // Validate that there is a value for each column
+    if(columns.size() != values.size()){
+        throw SQLiteDatabaseException("columns size must match values size");
+    }
+
+    auto sql = SqlBuilder::insert(table, columns);
+
+    ScopedStatement stmt(*statements_, sql, prepareCached(sql, "Error preparing statement "));
+
+    bindValues(stmt.get(), values, 1);
+
+    if(sqlite3_step(stmt.get()) != SQLITE_DONE){
+        throw SQLiteDatabaseException("Error executing insert statement " + getSQLite3ErrorMessage());
+    }
+
+    return sqlite3_last_insert_rowid(db_);
+}
+
+int SQLiteDatabase::update(const std::string& table, const std::vector<std::string>& columns,
+                           const std::vector<Value>& values, const std::string& selection,
+                           const std::vector<Value>& selectionArgs) {
+    if(columns.size() == 0){
+        throw SQLiteDatabaseException("columns vector must has at least one item");
+    }
+
+    // Validate that there is a value for each column
+    if(columns.size() != values.size()){
+        throw SQLiteDatabaseException("columns size must match values size");
+    }
+
+    auto sql = SqlBuilder::update(table, columns, selection);
+
+    ScopedStatement stmt(*statements_, sql, prepareCached(sql, "Error preparing update statement "));
+
+    // values fill the SET placeholders, the selection arguments follow them
+    bindValues(stmt.get(), values, 1);
+    bindValues(stmt.get(), selectionArgs, static_cast<int>(values.size()) + 1);
+
+    if(sqlite3_step(stmt.get()) != SQLITE_DONE){
+        throw SQLiteDatabaseException("Error executing update statement " + getSQLite3ErrorMessage());
+    }
+
+    return sqlite3_changes(db_);
+}
+
+int SQLiteDatabase::remove(const std::string& table, const std::string& selection,
+                           const std::vector<Value>& selectionArgs) {
+    if(selection.size() == 0){
+        throw SQLiteDatabaseException("selection must has at least one column name");
+    }
+
+    auto sql = SqlBuilder::remove(table, selection);
+
+    ScopedStatement stmt(*statements_, sql, prepareCached(sql, "Error preparing delete statement "));
+
+    bindValues(stmt.get(), selectionArgs, 1);
+
+    if(sqlite3_step(stmt.get()) != SQLITE_DONE){
+        throw SQLiteDatabaseException("Error executing delete statement " + getSQLite3ErrorMessage());
+    }
+
+    return sqlite3_changes(db_);
+}
+
+long long SQLiteDatabase::insertMany(const std::string& table, const std::vector<std::string>& columns,
+                                     const std::vector<std::vector<Value>>& rows, const std::size_t batchSize) {
+    std::size_t next = 0;
+
+    return insertMany(table, columns, [&rows, &next](std::vector<Value>& row) {
+        if (next == rows.size()) {
+            return false;
+        }
+
+        row = rows[next++];
+        return true;
+    }, batchSize);
+}
+
+long long SQLiteDatabase::insertMany(const std::string& table, const std::vector<std::string>& columns,
+                                     const RowGenerator& generator, const std::size_t batchSize) {
+    if(columns.size() == 0){
+        throw SQLiteDatabaseException("columns vector must has at least one item");
+    }
+
+    if(batchSize == 0){
+        throw SQLiteDatabaseException("batchSize must be greater than 0");
+    }
+
+    auto sql = SqlBuilder::insert(table, columns);
+
+    ScopedStatement stmt(*statements_, sql, prepareCached(sql, "Error preparing statement "));
+
+    // only manage transactions when the caller has not opened one
+    const bool ownTransaction = sqlite3_get_autocommit(db_) != 0;
+    bool inTransaction = false;
+
+    long long inserted = 0;
+    std::vector<Value> row;
+    row.reserve(columns.size());
+
+    try {
+        while (generator(row)) {
+            if (row.size() != columns.size()) {
+                throw SQLiteDatabaseException("columns size must match values size");
+            }
+
+            if (ownTransaction && !inTransaction) {
+                // the batch only writes, take the write lock up front
+                beginTransaction(Immediate);
+                inTransaction = true;
+            }
+
+            bindValues(stmt.get(), row, 1);
+
+            if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+                throw SQLiteDatabaseException("Error executing insert statement " + getSQLite3ErrorMessage());
+            }
+
+            sqlite3_reset(stmt.get());
+            row.clear();
+            inserted++;
+
+            if (inTransaction && inserted % batchSize == 0) {
+                endTransaction();
+                inTransaction = false;
+            }
+        }
+
+        if (inTransaction) {
+            endTransaction();
+        }
+    }
+    catch (...) {
+        if (inTransaction) {
+            sqlite3_reset(stmt.get());
+            rollback();
+        }
+        throw;
+    }
+
+    return inserted;
+}
+
+void SQLiteDatabase::checkColumnCount(sqlite3_stmt* stmt, const int expected) {
+    auto cols = sqlite3_column_count(stmt);
+
+    if (cols != expected) {
+        throw SQLiteDatabaseException("Query returns " + std::to_string(cols) + " columns, "
+                                      + std::to_string(expected) + " expected");
+    }
+}
+
+void SQLiteDatabase::checkDone(const int rc) {
+    if (rc != SQLITE_DONE) {
+        throw SQLiteDatabaseException("Error executing query " + getSQLite3ErrorMessage());
+    }
+}
+
+void SQLiteDatabase::bindValues(sqlite3_stmt* stmt, const std::vector<Value>& values, const int firstIndex) {
+    for(std::size_t ii = 0; ii < values.size(); ii++) {
+        auto index = firstIndex + static_cast<int>(ii);
+        if(values[ii].bind(stmt, index) != SQLITE_OK){
+            throw SQLiteDatabaseException("Error binding argument " + std::to_string(index) + " "
+                                          + getSQLite3ErrorMessage());
+        }
+    }
+}
+
+} /* namespace sqlite */
@@ -6,14 +6,24 @@
  */
 
 #include "SQLiteOpenHelper.h"
+#include "Transaction.h"
+
+#include <algorithm>
+#include <chrono>
 
 namespace sqlite {
 
 SQLiteOpenHelper::SQLiteOpenHelper(const std::string &database_name, const int version)
+        : SQLiteOpenHelper(database_name, version, OpenOptions()) {
+}
+
+SQLiteOpenHelper::SQLiteOpenHelper(const std::string &database_name, const int version, const OpenOptions& options)
         : database_name_(database_name),
           filename_(database_name + ".db"),
           version_(version),
-          read_only_(false) {
+          read_only_(false),
+          options_(options),
+          max_read_connections_(SQLiteConnectionPool::kDefaultMaxReadConnections) {
     if(version_ <= 0){
         throw new SQLiteDatabaseException("Database version must be an integer greater than 0");
     }
@@ -30,6 +40,11 @@ SQLiteDatabase& SQLiteOpenHelper::getWriteableDatabase() {
     return getDatabase(filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
 }
 
+QuerySubscription SQLiteOpenHelper::observe(const std::string& sql, const std::vector<Value>& args,
+                                            const QueryObserver::Callback& callback) {
+    return getWriteableDatabase().observe(sql, args, callback);
+}
+
 SQLiteDatabase& SQLiteOpenHelper::getDatabase(const std::string& filename, const int flags){
 
     // Lock other threads from trying to open the database at the same time
@@ -40,22 +55,35 @@ SQLiteDatabase& SQLiteOpenHelper::getDatabase(const std::string& filename, const
         return db_;
     }
 
+    // statements of a connection closed outside the helper
+    statements_.clear();
+
+    auto start = std::chrono::steady_clock::now();
+    open_stats_ = OpenStats();
+
     // Open the database
-    db_.open(filename, flags);
+    db_.open(filename, flags, options_);
+    auto opened = std::chrono::steady_clock::now();
 
-    // Create, upgrade, or downgrade if needed
-    if(db_.getVersion() == 0){
-        onCreate(db_);
-        db_.setVersion(version_);
-    }
-    else if(db_.getVersion() < version_){
-        onDowngrade(db_);
-        db_.setVersion(version_);
+    std::chrono::steady_clock::time_point migrated;
+    try {
+        open_stats_.migrated = prepareDatabase(db_);
+        migrated = std::chrono::steady_clock::now();
+
+        prepareStatements();
     }
-    else if(db_.getVersion() > version_){
-        onUpgrade(db_);
-        db_.setVersion(version_);
+    catch (...) {
+        // don't hand out a connection that was not migrated, the next call retries
+        statements_.clear();
+        db_.close();
+        throw;
     }
+    auto ready = std::chrono::steady_clock::now();
+
+    open_stats_.openTime = std::chrono::duration_cast<std::chrono::nanoseconds>(opened - start).count();
+    open_stats_.migrateTime = std::chrono::duration_cast<std::chrono::nanoseconds>(migrated - opened).count();
+    open_stats_.prepareTime = std::chrono::duration_cast<std::chrono::nanoseconds>(ready - migrated).count();
+    open_stats_.readyTime = std::chrono::duration_cast<std::chrono::nanoseconds>(ready - start).count();
 
     if(flags == SQLITE_OPEN_READONLY){
         read_only_ = true;
@@ -64,13 +92,144 @@ SQLiteDatabase& SQLiteOpenHelper::getDatabase(const std::string& filename, const
     return db_;
 }
 
+bool SQLiteOpenHelper::prepareDatabase(SQLiteDatabase& db) {
+    // A database at the current version only costs this one read
+    auto version = db.getVersion();
+    if(version == version_){
+        return false;
+    }
+
+    // Create, upgrade, or downgrade and set the version atomically, a failed migration leaves the old schema.
+    // Re-read under the write lock in case another connection migrated since the first read.
+    Transaction transaction(db, SQLiteDatabase::Immediate);
+    version = db.getVersion();
+
+    if(version == 0){
+        onCreate(db);
+    }
+    else if(version < version_){
+        onUpgrade(db);
+    }
+    else if(version > version_){
+        onDowngrade(db);
+    }
+    else{
+        return false;
+    }
+
+    db.setVersion(version_);
+    transaction.commit();
+
+    return true;
+}
+
+void SQLiteOpenHelper::prepareStatements() {
+    for (auto& statement : statement_sql_) {
+        statements_.insert(std::make_pair(statement.first, db_.prepare(statement.second)));
+    }
+}
+
+void SQLiteOpenHelper::registerStatement(const std::string& name, const std::string& sql) {
+    std::lock_guard<std::mutex> lock(db_mutex);
+
+    auto registered = std::find_if(statement_sql_.begin(), statement_sql_.end(),
+                                   [&name](const std::pair<std::string, std::string>& statement) {
+                                       return statement.first == name;
+                                   });
+    if (registered == statement_sql_.end()) {
+        statement_sql_.push_back(std::make_pair(name, sql));
+    }
+    else {
+        registered->second = sql;
+    }
+
+    // prepare now if the database is already open
+    if (db_.isOpen()) {
+        statements_.erase(name);
+        statements_.insert(std::make_pair(name, db_.prepare(sql)));
+    }
+}
+
+BoundStatement& SQLiteOpenHelper::getStatement(const std::string& name) {
+    if (!db_.isOpen()) {
+        getWriteableDatabase();
+    }
+
+    std::lock_guard<std::mutex> lock(db_mutex);
+
+    auto statement = statements_.find(name);
+    if (statement == statements_.end()) {
+        throw SQLiteDatabaseException("No statement registered as " + name);
+    }
+
+    return statement->second;
+}
+
+OpenStats SQLiteOpenHelper::getOpenStats() const {
+    return open_stats_;
+}
+
+SQLiteConnectionPool::Lease SQLiteOpenHelper::acquireReadableDatabase() {
+    return getConnectionPool().acquireReader();
+}
+
+SQLiteConnectionPool::Lease SQLiteOpenHelper::acquireWriteableDatabase() {
+    return getConnectionPool().acquireWriter();
+}
+
+void SQLiteOpenHelper::setMaxReadConnections(const std::size_t maxReadConnections) {
+    std::lock_guard<std::mutex> lock(db_mutex);
+
+    if (pool_) {
+        throw SQLiteDatabaseException("Connection pool already open");
+    }
+
+    max_read_connections_ = maxReadConnections;
+}
+
+SQLiteConnectionPool& SQLiteOpenHelper::getConnectionPool() {
+
+    // Lock other threads from trying to open the pool at the same time
+    std::lock_guard<std::mutex> lock(db_mutex);
+
+    if (pool_ && pool_->isOpen()) {
+        return *pool_;
+    }
+
+    if (!pool_) {
+        pool_.reset(new SQLiteConnectionPool(filename_, max_read_connections_, options_));
+    }
+
+    pool_->open();
+
+    // Create or upgrade through the writer before any reader opens the file
+    try {
+        auto writer = pool_->acquireWriter();
+        prepareDatabase(*writer);
+    }
+    catch (...) {
+        // don't hand out connections that were not migrated, the next call retries
+        pool_->close();
+        throw;
+    }
+
+    return *pool_;
+}
+
 void SQLiteOpenHelper::close() {
     std::lock_guard<std::mutex> lock(db_mutex);
 
+    // the statements keep the connection busy
+    statements_.clear();
+
     if (db_.isOpen()) {
         db_.close();
     }
 
+    if (pool_) {
+        pool_->close();
+    }
+
     read_only_ = false;
 }
 
@@ -0,0 +1,195 @@
+/*
+ * File:   SQLiteWriteQueue.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include "SQLiteWriteQueue.h"
+#include "Transaction.h"
+
+namespace sqlite {
+
+const std::size_t SQLiteWriteQueue::kDefaultMaxBatchSize;
+
+SQLiteWriteQueue::SQLiteWriteQueue(SQLiteDatabase& db, const std::size_t maxBatchSize,
+                                   const std::chrono::milliseconds maxBatchDelay)
+        : db_(db),
+          maxBatchSize_(maxBatchSize == 0 ? 1 : maxBatchSize),
+          maxBatchDelay_(maxBatchDelay),
+          stopping_(false),
+          batchesCommitted_(0),
+          mutationsCommitted_(0),
+          worker_(&SQLiteWriteQueue::run, this) {
+}
+
+SQLiteWriteQueue::SQLiteWriteQueue(SQLiteConnectionPool::Lease&& lease, const std::size_t maxBatchSize,
+                                   const std::chrono::milliseconds maxBatchDelay)
+        : lease_(new SQLiteConnectionPool::Lease(std::move(lease))),
+          db_(lease_->get()),
+          maxBatchSize_(maxBatchSize == 0 ? 1 : maxBatchSize),
+          maxBatchDelay_(maxBatchDelay),
+          stopping_(false),
+          batchesCommitted_(0),
+          mutationsCommitted_(0),
+          worker_(&SQLiteWriteQueue::run, this) {
+}
+
+SQLiteWriteQueue::~SQLiteWriteQueue() {
+    shutdown();
+}
+
+std::future<void> SQLiteWriteQueue::submit(Mutation mutation) {
+    auto promise = std::make_shared<std::promise<void>>();
+    auto result = promise->get_future();
+
+    Entry entry;
+    entry.apply = std::move(mutation);
+    entry.commit = [promise]() { promise->set_value(); };
+    entry.fail = [promise](std::exception_ptr e) { promise->set_exception(e); };
+
+    enqueue(std::move(entry));
+
+    return result;
+}
+
+std::future<long long> SQLiteWriteQueue::insert(const std::string& table, const std::vector<std::string>& columns,
+                                                const std::vector<Value>& values) {
+    auto promise = std::make_shared<std::promise<long long>>();
+    auto rowid = std::make_shared<long long>(0);
+    auto result = promise->get_future();
+
+    Entry entry;
+    entry.apply = [table, columns, values, rowid](SQLiteDatabase& db) { *rowid = db.insert(table, columns, values); };
+    entry.commit = [promise, rowid]() { promise->set_value(*rowid); };
+    entry.fail = [promise](std::exception_ptr e) { promise->set_exception(e); };
+
+    enqueue(std::move(entry));
+
+    return result;
+}
+
+void SQLiteWriteQueue::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+
+    queueChanged_.notify_one();
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+unsigned long long SQLiteWriteQueue::batchesCommitted() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batchesCommitted_;
+}
+
+unsigned long long SQLiteWriteQueue::mutationsCommitted() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return mutationsCommitted_;
+}
+
+void SQLiteWriteQueue::enqueue(Entry entry) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (stopping_) {
+            throw SQLiteDatabaseException("Write queue is shut down");
+        }
+
+        queue_.push_back(std::move(entry));
+    }
+
+    queueChanged_.notify_one();
+}
+
+void SQLiteWriteQueue::run() {
+    std::vector<Entry> batch;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            queueChanged_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+
+            // drain the queue before stopping
+            if (queue_.empty()) {
+                return;
+            }
+
+            // give other writers a chance to join the batch
+            auto deadline = std::chrono::steady_clock::now() + maxBatchDelay_;
+            while (!stopping_ && queue_.size() < maxBatchSize_) {
+                if (queueChanged_.wait_until(lock, deadline) == std::cv_status::timeout) {
+                    break;
+                }
+            }
+
+            while (!queue_.empty() && batch.size() < maxBatchSize_) {
+                batch.push_back(std::move(queue_.front()));
+                queue_.pop_front();
+            }
+        }
+
+        commitBatch(batch);
+        batch.clear();
+    }
+}
+
+void SQLiteWriteQueue::commitBatch(std::vector<Entry>& batch) {
+    try {
+        db_.beginTransaction(SQLiteDatabase::Immediate);
+    }
+    catch (...) {
+        for (auto& entry : batch) {
+            entry.fail(std::current_exception());
+        }
+        return;
+    }
+
+    std::vector<Entry*> applied;
+
+    for (auto& entry : batch) {
+        try {
+            // nested in the batch transaction the guard is a savepoint, a failure undoes only this mutation and
+            // the rest of the batch still commits
+            Transaction savepoint(db_);
+            entry.apply(db_);
+            savepoint.commit();
+            applied.push_back(&entry);
+        }
+        catch (...) {
+            entry.fail(std::current_exception());
+        }
+    }
+
+    try {
+        db_.endTransaction();
+    }
+    catch (...) {
+        auto error = std::current_exception();
+        try {
+            db_.rollback();
+        }
+        catch (...) {
+        }
+        for (auto entry : applied) {
+            entry->fail(error);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        batchesCommitted_++;
+        mutationsCommitted_ += applied.size();
+    }
+
+    for (auto entry : applied) {
+        entry->commit();
+    }
+}
+
+} /* namespace sqlite */
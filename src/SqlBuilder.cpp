@@ -0,0 +1,113 @@
+/*
+ * File:   SqlBuilder.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include "SqlBuilder.h"
+
+namespace sqlite {
+
+std::string SqlBuilder::select(const bool distinct, const std::string& table, const std::vector<std::string>& columns,
+                               const std::string& selection, const std::string& groupBy, const std::string& orderBy,
+                               const std::string& limit) {
+    std::string sql;
+    sql.reserve(64 + table.size() + length(columns, 2) + selection.size() + groupBy.size() + orderBy.size() +
+                limit.size());
+
+    sql += distinct ? "SELECT DISTINCT " : "SELECT ";
+
+    if (columns.empty()) {
+        sql += "* ";
+    }
+    else {
+        for (std::size_t ii = 0; ii < columns.size(); ii++) {
+            sql += columns[ii];
+            sql += (ii < columns.size() - 1 ? ", " : " ");
+        }
+    }
+
+    sql += "FROM ";
+    sql += table;
+
+    appendClause(sql, " WHERE ", selection);
+    appendClause(sql, " GROUP BY ", groupBy);
+    appendClause(sql, " ORDER BY ", orderBy);
+    appendClause(sql, " LIMIT ", limit);
+
+    return sql;
+}
+
+std::string SqlBuilder::insert(const std::string& table, const std::vector<std::string>& columns) {
+    std::string sql;
+    sql.reserve(32 + table.size() + length(columns, 5));
+
+    sql += "INSERT INTO ";
+    sql += table;
+    sql += "(";
+
+    for (std::size_t ii = 0; ii < columns.size(); ii++) {
+        sql += columns[ii];
+        if (ii < columns.size() - 1) {
+            sql += ", ";
+        }
+    }
+
+    // one placeholder per column
+    sql += ") VALUES (";
+    for (std::size_t ii = 0; ii < columns.size(); ii++) {
+        sql += (ii < columns.size() - 1 ? "?, " : "?");
+    }
+    sql += ")";
+
+    return sql;
+}
+
+std::string SqlBuilder::update(const std::string& table, const std::vector<std::string>& columns,
+                               const std::string& selection) {
+    std::string sql;
+    sql.reserve(32 + table.size() + length(columns, 6) + selection.size());
+
+    sql += "UPDATE ";
+    sql += table;
+    sql += " SET ";
+
+    for (std::size_t ii = 0; ii < columns.size(); ii++) {
+        sql += columns[ii];
+        sql += (ii < columns.size() - 1 ? " = ?, " : " = ?");
+    }
+
+    appendClause(sql, " WHERE ", selection);
+
+    return sql;
+}
+
+std::string SqlBuilder::remove(const std::string& table, const std::string& selection) {
+    std::string sql;
+    sql.reserve(32 + table.size() + selection.size());
+
+    sql += "DELETE FROM ";
+    sql += table;
+
+    appendClause(sql, " WHERE ", selection);
+
+    return sql;
+}
+
+std::size_t SqlBuilder::length(const std::vector<std::string>& columns, const std::size_t perColumn) {
+    std::size_t size = 0;
+    for (auto& column : columns) {
+        size += column.size() + perColumn;
+    }
+    return size;
+}
+
+void SqlBuilder::appendClause(std::string& sql, const char* keyword, const std::string& clause) {
+    if (!clause.empty()) {
+        sql += keyword;
+        sql += clause;
+    }
+}
+
+} /* namespace sqlite */
@@ -0,0 +1,126 @@
+/*
+ * File:   StatementCache.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include "StatementCache.h"
+
+namespace sqlite {
+
+const std::size_t StatementCache::kDefaultCapacity;
+
+StatementCache::StatementCache(const std::size_t capacity) : capacity_(capacity), hits_(0), misses_(0) {
+}
+
+StatementCache::~StatementCache() {
+    clear();
+}
+
+int StatementCache::acquire(sqlite3* db, const std::string& sql, sqlite3_stmt** stmt, bool* cacheHit) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = index_.find(sql);
+
+        if (it != index_.end()) {
+            // check the statement out so no one else can step it
+            *stmt = it->second->second;
+            lru_.erase(it->second);
+            index_.erase(it);
+            hits_++;
+
+            if (cacheHit != nullptr) {
+                *cacheHit = true;
+            }
+            return SQLITE_OK;
+        }
+
+        misses_++;
+    }
+
+    if (cacheHit != nullptr) {
+        *cacheHit = false;
+    }
+
+    // prepare outside the lock, parsing is the expensive part
+    auto rc = sqlite3_prepare_v2(db, sql.c_str(), static_cast<int>(sql.size()), stmt, nullptr);
+
+    if (rc != SQLITE_OK) {
+        sqlite3_finalize(*stmt);
+        *stmt = nullptr;
+    }
+
+    return rc;
+}
+
+void StatementCache::release(const std::string& sql, sqlite3_stmt* stmt) {
+    if (stmt == nullptr) {
+        return;
+    }
+
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Another caller already returned the same sql, or caching is disabled
+    if (capacity_ == 0 || index_.find(sql) != index_.end()) {
+        sqlite3_finalize(stmt);
+        return;
+    }
+
+    lru_.push_front(std::make_pair(sql, stmt));
+    index_[sql] = lru_.begin();
+
+    evict(capacity_);
+}
+
+void StatementCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    evict(0);
+}
+
+void StatementCache::setCapacity(const std::size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    evict(capacity_);
+}
+
+std::size_t StatementCache::capacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+std::size_t StatementCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_.size();
+}
+
+unsigned long long StatementCache::hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+unsigned long long StatementCache::misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+void StatementCache::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    hits_ = 0;
+    misses_ = 0;
+}
+
+void StatementCache::evict(const std::size_t capacity) {
+    // caller holds mutex_
+    while (lru_.size() > capacity) {
+        sqlite3_finalize(lru_.back().second);
+        index_.erase(lru_.back().first);
+        lru_.pop_back();
+    }
+}
+
+} /* namespace sqlite */
@@ -0,0 +1,205 @@
+/*
+ * File:   StatementStats.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include "StatementStats.h"
+
+#include <cctype>
+
+namespace sqlite {
+
+const int StatementStats::Histogram::kBuckets;
+const std::size_t StatementStats::kMaxRememberedSql;
+
+StatementStats::Histogram::Histogram() : count(0), total(0), max(0) {
+    for (auto ii = 0; ii < kBuckets; ii++) {
+        buckets[ii] = 0;
+    }
+}
+
+void StatementStats::Histogram::record(const unsigned long long nanoseconds) {
+    // bucket is the bit length of the value
+    auto bucket = 0;
+    for (auto value = nanoseconds; value != 0 && bucket < kBuckets - 1; value >>= 1) {
+        bucket++;
+    }
+
+    buckets[bucket]++;
+    count++;
+    total += nanoseconds;
+
+    if (nanoseconds > max) {
+        max = nanoseconds;
+    }
+}
+
+unsigned long long StatementStats::Histogram::percentile(const double p) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    auto target = static_cast<unsigned long long>(p * count);
+    unsigned long long seen = 0;
+
+    for (auto ii = 0; ii < kBuckets; ii++) {
+        seen += buckets[ii];
+        if (seen > target || seen == count) {
+            return ii == 0 ? 0 : (1ULL << ii) - 1;
+        }
+    }
+
+    return max;
+}
+
+double StatementStats::Histogram::mean() const {
+    return count == 0 ? 0.0 : static_cast<double>(total) / count;
+}
+
+StatementStats::Entry::Entry()
+        : executions(0), rowsReturned(0), rowsChanged(0), cacheHits(0), cacheMisses(0), bytesMaterialized(0) {
+}
+
+StatementStats::StatementStats() {
+}
+
+StatementStats::~StatementStats() {
+}
+
+void StatementStats::recordPrepare(const std::string& sql, const unsigned long long nanoseconds, const bool cacheHit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto& e = entry(sql);
+    e.prepareTime.record(nanoseconds);
+
+    if (cacheHit) {
+        e.cacheHits++;
+    }
+    else {
+        e.cacheMisses++;
+    }
+}
+
+void StatementStats::recordExecution(const char* sql, const unsigned long long nanoseconds,
+                                     const unsigned long long rowsChanged) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto& e = entry(sql == nullptr ? "" : sql);
+    e.executions++;
+    e.stepTime.record(nanoseconds);
+    e.rowsChanged += rowsChanged;
+}
+
+void StatementStats::recordResult(const char* sql, const unsigned long long rows, const unsigned long long bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto& e = entry(sql == nullptr ? "" : sql);
+    e.rowsReturned += rows;
+    e.bytesMaterialized += bytes;
+}
+
+std::vector<StatementStats::Entry> StatementStats::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_;
+}
+
+void StatementStats::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    normalizedIndex_.clear();
+}
+
+StatementStats::Entry& StatementStats::entry(const std::string& sql) {
+    // caller holds mutex_
+    auto it = index_.find(sql);
+
+    if (it != index_.end()) {
+        return entries_[it->second];
+    }
+
+    auto normalized = normalize(sql);
+
+    // sql with inlined literals is different on every call, keep the memo bounded
+    if (index_.size() >= kMaxRememberedSql) {
+        index_.clear();
+    }
+
+    // different raw sql can normalize to the same entry
+    auto normalizedIt = normalizedIndex_.find(normalized);
+    if (normalizedIt != normalizedIndex_.end()) {
+        index_[sql] = normalizedIt->second;
+        return entries_[normalizedIt->second];
+    }
+
+    entries_.push_back(Entry());
+    entries_.back().sql = normalized;
+    normalizedIndex_[normalized] = entries_.size() - 1;
+    index_[sql] = entries_.size() - 1;
+
+    return entries_.back();
+}
+
+std::string StatementStats::normalize(const std::string& sql) {
+    std::string normalized;
+    normalized.reserve(sql.size());
+
+    auto ii = 0;
+    auto size = static_cast<int>(sql.size());
+
+    while (ii < size) {
+        auto c = sql[ii];
+
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            while (ii < size && std::isspace(static_cast<unsigned char>(sql[ii]))) {
+                ii++;
+            }
+            if (!normalized.empty()) {
+                normalized += ' ';
+            }
+            continue;
+        }
+
+        // string and blob literals, '' is an escaped quote
+        if (c == '\'') {
+            ii++;
+            while (ii < size) {
+                if (sql[ii] == '\'' && (ii + 1 >= size || sql[ii + 1] != '\'')) {
+                    break;
+                }
+                ii += (sql[ii] == '\'') ? 2 : 1;
+            }
+            ii++;
+            if (!normalized.empty() && (normalized.back() == 'x' || normalized.back() == 'X')) {
+                normalized.pop_back();
+            }
+            normalized += '?';
+            continue;
+        }
+
+        // numbers that are not part of an identifier
+        auto previous = normalized.empty() ? ' ' : normalized.back();
+        if (std::isdigit(static_cast<unsigned char>(c)) && !std::isalnum(static_cast<unsigned char>(previous))
+            && previous != '_') {
+            while (ii < size && (std::isalnum(static_cast<unsigned char>(sql[ii])) || sql[ii] == '.')) {
+                ii++;
+            }
+            normalized += '?';
+            continue;
+        }
+
+        normalized += c;
+        ii++;
+    }
+
+    // trailing whitespace and statement terminator
+    while (!normalized.empty() && (normalized.back() == ' ' || normalized.back() == ';')) {
+        normalized.pop_back();
+    }
+
+    return normalized;
+}
+
+} /* namespace sqlite */
@@ -0,0 +1,157 @@
+/*
+ * File:   StreamingCursor.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include <SQLiteDatabase.h>
+#include "StreamingCursor.h"
+
+namespace sqlite {
+
+StreamingCursor::StreamingCursor(const std::shared_ptr<StatementCache>& cache, const std::string& sql,
+                                 sqlite3_stmt* stmt)
+        : cache_(cache), sql_(sql), stmt_(stmt), pos_(0), done_(false) {
+    auto cols = sqlite3_column_count(stmt_);
+    for (auto col = 0; col < cols; col++) {
+        columnNames.push_back(std::string(sqlite3_column_name(stmt_, col)));
+    }
+}
+
+StreamingCursor::StreamingCursor(StreamingCursor&& other)
+        : cache_(std::move(other.cache_)), sql_(std::move(other.sql_)), stmt_(other.stmt_),
+          columnNames(std::move(other.columnNames)), pos_(other.pos_), done_(other.done_) {
+    other.stmt_ = nullptr;
+    other.done_ = true;
+}
+
+StreamingCursor& StreamingCursor::operator=(StreamingCursor&& other) {
+    if (this != &other) {
+        close();
+
+        cache_ = std::move(other.cache_);
+        sql_ = std::move(other.sql_);
+        stmt_ = other.stmt_;
+        columnNames = std::move(other.columnNames);
+        pos_ = other.pos_;
+        done_ = other.done_;
+
+        other.stmt_ = nullptr;
+        other.done_ = true;
+    }
+
+    return *this;
+}
+
+StreamingCursor::~StreamingCursor() {
+    close();
+}
+
+void StreamingCursor::close() {
+    if (stmt_ != nullptr) {
+        // hand the statement back so the next query with the same sql skips the prepare
+        cache_->release(sql_, stmt_);
+        stmt_ = nullptr;
+    }
+
+    done_ = true;
+}
+
+bool StreamingCursor::next() {
+    if (done_) {
+        return false;
+    }
+
+    auto rc = sqlite3_step(stmt_);
+
+    if (rc == SQLITE_ROW) {
+        pos_++;
+        return true;
+    }
+
+    if (rc == SQLITE_DONE) {
+        // release the read lock as soon as the result set is exhausted
+        close();
+        return false;
+    }
+
+    std::string errorMsg = "Error stepping statement " + std::string(sqlite3_errmsg(sqlite3_db_handle(stmt_)));
+    close();
+    throw SQLiteDatabaseException(errorMsg);
+}
+
+int StreamingCursor::getColumnIndex(const std::string& columnName) const {
+    for (std::size_t col = 0; col < columnNames.size(); col++) {
+        if (columnNames[col] == columnName) {
+            return static_cast<int>(col);
+        }
+    }
+
+    throw SQLiteDatabaseException("Invalid column name " + columnName);
+}
+
+int StreamingCursor::checkColumnIndex(const int columnIndex) const {
+    if (stmt_ == nullptr || pos_ == 0) {
+        throw SQLiteDatabaseException("Cursor is not positioned on a row");
+    }
+
+    if (columnIndex < 1 || columnIndex > static_cast<int>(columnNames.size())) {
+        throw SQLiteDatabaseException("Invalid column index");
+    }
+
+    return columnIndex - 1;
+}
+
+std::string StreamingCursor::getString(const int columnIndex) const {
+    auto col = checkColumnIndex(columnIndex);
+    auto text = sqlite3_column_text(stmt_, col);
+
+    if (text == nullptr) {
+        return std::string();
+    }
+
+    return std::string(reinterpret_cast<const char*>(text), sqlite3_column_bytes(stmt_, col));
+}
+
+std::string StreamingCursor::getString(const std::string& columnName) const {
+    return getString(getColumnIndex(columnName) + 1);
+}
+
+int StreamingCursor::getInt(const int columnIndex) const {
+    return sqlite3_column_int(stmt_, checkColumnIndex(columnIndex));
+}
+
+int StreamingCursor::getInt(const std::string& columnName) const {
+    return getInt(getColumnIndex(columnName) + 1);
+}
+
+double StreamingCursor::getDouble(const int columnIndex) const {
+    return sqlite3_column_double(stmt_, checkColumnIndex(columnIndex));
+}
+
+double StreamingCursor::getDouble(const std::string& columnName) const {
+    return getDouble(getColumnIndex(columnName) + 1);
+}
+
+long StreamingCursor::getLong(const int columnIndex) const {
+    return static_cast<long>(sqlite3_column_int64(stmt_, checkColumnIndex(columnIndex)));
+}
+
+long StreamingCursor::getLong(const std::string& columnName) const {
+    return getLong(getColumnIndex(columnName) + 1);
+}
+
+bool StreamingCursor::isNull(const int columnIndex) const {
+    return sqlite3_column_type(stmt_, checkColumnIndex(columnIndex)) == SQLITE_NULL;
+}
+
+bool StreamingCursor::isNull(const std::string& columnName) const {
+    return isNull(getColumnIndex(columnName) + 1);
+}
+
+Value::Type StreamingCursor::getType(const int columnIndex) const {
+    return static_cast<Value::Type>(sqlite3_column_type(stmt_, checkColumnIndex(columnIndex)));
+}
+
+} /* namespace sqlite */
@@ -0,0 +1,284 @@
+/*
+ * File:   TableChangeTracker.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include <SQLiteDatabase.h>
+#include "TableChangeTracker.h"
+
+#include <vector>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace sqlite {
+
+namespace {
+
+// built in functions whose result changes between calls with the same arguments
+const char* const kVolatileFunctions[] = {"random", "randomblob", "changes", "total_changes", "last_insert_rowid",
+                                          "sqlite_offset"};
+
+// date and time functions, volatile when called with 'now' or without a time value
+const char* const kDateFunctions[] = {"date", "time", "datetime", "julianday", "unixepoch", "strftime", "timediff"};
+
+template <std::size_t N>
+bool contains(const char* const (&names)[N], const char* name) {
+    for (auto candidate : names) {
+        if (sqlite3_stricmp(candidate, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool isVolatileFunction(const char* name) {
+    return contains(kVolatileFunctions, name);
+}
+
+bool isDateFunction(const char* name) {
+    return contains(kDateFunctions, name);
+}
+
+std::string lowerCase(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+/** The authorizer doesn't see arguments, look for 'now', a date function without arguments or CURRENT_TIME,
+ * CURRENT_DATE and CURRENT_TIMESTAMP in the sql instead. Also true for 'now' in other places, those results just
+ * aren't cached. */
+bool usesCurrentTime(const std::string& sql, const bool hasDateFunction) {
+    std::string compact;
+    for (unsigned char c : sql) {
+        if (!std::isspace(c)) {
+            compact += static_cast<char>(std::tolower(c));
+        }
+    }
+
+    if (compact.find("current_date") != std::string::npos || compact.find("current_time") != std::string::npos) {
+        return true;
+    }
+    if (!hasDateFunction) {
+        return false;
+    }
+    if (compact.find("now") != std::string::npos) {
+        return true;
+    }
+    for (auto name : kDateFunctions) {
+        if (compact.find(std::string(name) + "()") != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} /* namespace */
+
+const std::size_t TableChangeTracker::kMaxRememberedSql;
+
+TableChangeTracker::TableChangeTracker(sqlite3* db)
+        : db_(db), schemaChanged_(false), reads_(nullptr), nextId_(0) {
+    sqlite3_update_hook(db_, updateHook, this);
+    sqlite3_commit_hook(db_, commitHook, this);
+    sqlite3_rollback_hook(db_, rollbackHook, this);
+    sqlite3_set_authorizer(db_, authorizer, this);
+}
+
+TableChangeTracker::~TableChangeTracker() {
+    sqlite3_update_hook(db_, nullptr, nullptr);
+    sqlite3_commit_hook(db_, nullptr, nullptr);
+    sqlite3_rollback_hook(db_, nullptr, nullptr);
+    sqlite3_set_authorizer(db_, nullptr, nullptr);
+}
+
+int TableChangeTracker::addListener(const Listener& listener) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    listeners_[nextId_] = listener;
+    return nextId_++;
+}
+
+void TableChangeTracker::removeListener(const int id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    listeners_.erase(id);
+}
+
+std::set<std::string> TableChangeTracker::tablesRead(const std::string& sql) {
+    return reads(sql).tables;
+}
+
+bool TableChangeTracker::isDeterministic(const std::string& sql) {
+    auto read = reads(sql);
+    if (read.volatileResult || read.tables.empty()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto& table : read.tables) {
+        // eponymous pragma tables, eg. pragma_table_info, are pragmas too
+        if (volatileTables_.count(lowerCase(table)) != 0 || sqlite3_strnicmp(table.c_str(), "pragma_", 7) == 0) {
+            return false;
+        }
+    }
+    for (auto& function : read.functions) {
+        if (volatileFunctions_.count(function) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TableChangeTracker::addVolatileTable(const std::string& table) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    volatileTables_.insert(lowerCase(table));
+}
+
+void TableChangeTracker::addVolatileFunction(const std::string& function) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    volatileFunctions_.insert(lowerCase(function));
+}
+
+TableChangeTracker::Reads TableChangeTracker::reads(const std::string& sql) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = tablesRead_.find(sql);
+        if (it != tablesRead_.end()) {
+            return it->second;
+        }
+    }
+
+    Reads read;
+    read.volatileResult = false;
+    read.hasDateFunction = false;
+    sqlite3_stmt* stmt = nullptr;
+
+    // hold the connection mutex so reads from other prepares are not collected
+    auto connectionMutex = sqlite3_db_mutex(db_);
+    sqlite3_mutex_enter(connectionMutex);
+
+    reads_ = &read;
+    auto rc = sqlite3_prepare_v2(db_, sql.c_str(), static_cast<int>(sql.size()), &stmt, nullptr);
+    reads_ = nullptr;
+    sqlite3_finalize(stmt);
+
+    sqlite3_mutex_leave(connectionMutex);
+
+    if (rc != SQLITE_OK) {
+        throw SQLiteDatabaseException("Error preparing statement " + std::string(sqlite3_errstr(rc)));
+    }
+
+    if (usesCurrentTime(sql, read.hasDateFunction)) {
+        read.volatileResult = true;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (tablesRead_.size() >= kMaxRememberedSql) {
+        tablesRead_.clear();
+    }
+    tablesRead_[sql] = read;
+
+    return read;
+}
+
+void TableChangeTracker::notifyAllChanged() {
+    notify(std::set<std::string>(), true);
+}
+
+void TableChangeTracker::notify(const std::set<std::string>& tables, const bool allTables) {
+    std::vector<Listener> listeners;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& listener : listeners_) {
+            listeners.push_back(listener.second);
+        }
+    }
+
+    for (auto& listener : listeners) {
+        listener(tables, allTables);
+    }
+}
+
+void TableChangeTracker::updateHook(void* context, int, const char*, const char* table, sqlite3_int64) {
+    static_cast<TableChangeTracker*>(context)->pending_.insert(table);
+}
+
+int TableChangeTracker::commitHook(void* context) {
+    auto tracker = static_cast<TableChangeTracker*>(context);
+
+    if (!tracker->pending_.empty() || tracker->schemaChanged_) {
+        tracker->notify(tracker->pending_, tracker->schemaChanged_);
+    }
+
+    tracker->pending_.clear();
+    tracker->schemaChanged_ = false;
+
+    // 0 lets the commit go ahead
+    return 0;
+}
+
+void TableChangeTracker::rollbackHook(void* context) {
+    static_cast<TableChangeTracker*>(context)->pending_.clear();
+}
+
+int TableChangeTracker::authorizer(void* context, int action, const char* arg1, const char* arg2, const char*,
+                                   const char*) {
+    auto tracker = static_cast<TableChangeTracker*>(context);
+
+    switch (action) {
+        case SQLITE_READ:
+            if (tracker->reads_ != nullptr && arg1 != nullptr) {
+                tracker->reads_->tables.insert(arg1);
+            }
+            break;
+        case SQLITE_PRAGMA:
+            if (tracker->reads_ != nullptr) {
+                tracker->reads_->volatileResult = true;
+            }
+            break;
+        case SQLITE_FUNCTION:
+            if (tracker->reads_ != nullptr && arg2 != nullptr) {
+                // application functions are checked against volatileFunctions_ when the statement is used, they can
+                // be registered after the reads were remembered
+                tracker->reads_->functions.insert(lowerCase(arg2));
+
+                if (isVolatileFunction(arg2)) {
+                    tracker->reads_->volatileResult = true;
+                }
+                else if (isDateFunction(arg2)) {
+                    tracker->reads_->hasDateFunction = true;
+                }
+            }
+            break;
+        case SQLITE_DELETE:
+            // IGNORE keeps the delete but makes SQLite delete row by row so the update hook sees it. DROP also checks
+            // DELETE on the dropped table and the schema table, IGNORE would cancel the DROP there.
+            if (arg1 == nullptr || tracker->reads_ != nullptr || std::strncmp(arg1, "sqlite_", 7) == 0) {
+                break;
+            }
+            if (tracker->dropped_ == arg1) {
+                tracker->dropped_.clear();
+                break;
+            }
+            return SQLITE_IGNORE;
+        case SQLITE_DROP_TABLE:
+        case SQLITE_DROP_TEMP_TABLE:
+        case SQLITE_DROP_VIEW:
+        case SQLITE_DROP_TEMP_VIEW:
+            tracker->dropped_ = arg1 == nullptr ? "" : arg1;
+            tracker->schemaChanged_ = true;
+            break;
+        case SQLITE_ALTER_TABLE:
+            tracker->schemaChanged_ = true;
+            break;
+        default:
+            break;
+    }
+
+    return SQLITE_OK;
+}
+
+} /* namespace sqlite */
@@ -0,0 +1,125 @@
+/*
+ * File:   Transaction.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include "Transaction.h"
+
+namespace sqlite {
+
+Transaction::Transaction(SQLiteDatabase& db, const SQLiteDatabase::TransactionMode mode)
+        : db_(db), nested_(db.inTransaction()), active_(false) {
+    if (nested_) {
+        db_.savepoint();
+    }
+    else {
+        db_.beginTransaction(mode);
+    }
+
+    active_ = true;
+}
+
+Transaction::~Transaction() {
+    if (!active_) {
+        return;
+    }
+
+    // destructors must not throw, a failed rollback leaves nothing more to undo here
+    try {
+        rollback();
+    }
+    catch (...) {
+    }
+}
+
+void Transaction::commit() {
+    if (!active_) {
+        throw SQLiteDatabaseException("Transaction is not active");
+    }
+
+    if (nested_) {
+        db_.releaseSavepoint();
+    }
+    else {
+        db_.endTransaction();
+    }
+
+    active_ = false;
+}
+
+void Transaction::rollback() {
+    if (!active_) {
+        throw SQLiteDatabaseException("Transaction is not active");
+    }
+
+    active_ = false;
+
+    // an error like SQLITE_FULL may already have rolled the whole transaction back
+    if (!db_.inTransaction()) {
+        return;
+    }
+
+    if (nested_) {
+        db_.rollbackToSavepoint();
+    }
+    else {
+        db_.rollback();
+    }
+}
+
+TransactionStatements::TransactionStatements() {
+    for (auto& stmt : statements_) {
+        stmt = nullptr;
+    }
+}
+
+TransactionStatements::~TransactionStatements() {
+    clear();
+}
+
+void TransactionStatements::exec(sqlite3* db, const Kind kind) {
+    // one savepoint name is enough, RELEASE and ROLLBACK TO act on the most recent savepoint with the name
+    static const char* kSql[kKindCount] = {
+        "BEGIN",
+        "BEGIN IMMEDIATE",
+        "BEGIN EXCLUSIVE",
+        "COMMIT",
+        "ROLLBACK",
+        "SAVEPOINT cppqlite_savepoint",
+        "RELEASE cppqlite_savepoint",
+        "ROLLBACK TO cppqlite_savepoint"
+    };
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto& stmt = statements_[kind];
+
+    if (stmt == nullptr && sqlite3_prepare_v2(db, kSql[kind], -1, &stmt, nullptr) != SQLITE_OK) {
+        sqlite3_finalize(stmt);
+        stmt = nullptr;
+        throw SQLiteDatabaseException("Error preparing sql " + std::string(kSql[kind]) + " " + sqlite3_errmsg(db));
+    }
+
+    auto rc = sqlite3_step(stmt);
+
+    if (rc != SQLITE_DONE) {
+        std::string errorMsg = "Error executing sql " + std::string(sqlite3_errmsg(db));
+        sqlite3_reset(stmt);
+        throw SQLiteDatabaseException(errorMsg);
+    }
+
+    sqlite3_reset(stmt);
+}
+
+void TransactionStatements::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto& stmt : statements_) {
+        sqlite3_finalize(stmt);
+        stmt = nullptr;
+    }
+}
+
+} /* namespace sqlite */
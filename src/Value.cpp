@@ -0,0 +1,108 @@
+/*
+ * File:   Value.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include "Value.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace sqlite {
+
+Value Value::blob(const void* data, const std::size_t size) {
+    Value v;
+    v.type_ = Blob;
+    v.bytes_.assign(static_cast<const char*>(data), size);
+    return v;
+}
+
+Value Value::fromColumn(sqlite3_stmt* stmt, const int col) {
+    switch (sqlite3_column_type(stmt, col)) {
+        case SQLITE_INTEGER:
+            return Value(static_cast<long long>(sqlite3_column_int64(stmt, col)));
+        case SQLITE_FLOAT:
+            return Value(sqlite3_column_double(stmt, col));
+        case SQLITE_TEXT: {
+            Value v;
+            v.type_ = Text;
+            v.bytes_.assign(reinterpret_cast<const char*>(sqlite3_column_text(stmt, col)),
+                            sqlite3_column_bytes(stmt, col));
+            return v;
+        }
+        case SQLITE_BLOB: {
+            // sqlite3_column_blob must be called before sqlite3_column_bytes
+            auto data = sqlite3_column_blob(stmt, col);
+            return blob(data, sqlite3_column_bytes(stmt, col));
+        }
+        default:
+            return Value();
+    }
+}
+
+int Value::bind(sqlite3_stmt* stmt, const int index) const {
+    switch (type_) {
+        case Integer:
+            return sqlite3_bind_int64(stmt, index, integer_);
+        case Float:
+            return sqlite3_bind_double(stmt, index, float_);
+        case Text:
+            return sqlite3_bind_text(stmt, index, bytes_.data(), static_cast<int>(bytes_.size()), SQLITE_TRANSIENT);
+        case Blob:
+            return sqlite3_bind_blob(stmt, index, bytes_.data(), static_cast<int>(bytes_.size()), SQLITE_TRANSIENT);
+        default:
+            return sqlite3_bind_null(stmt, index);
+    }
+}
+
+long long Value::asInt64() const {
+    switch (type_) {
+        case Integer:
+            return integer_;
+        case Float:
+            return static_cast<long long>(float_);
+        case Text:
+            return std::strtoll(bytes_.c_str(), nullptr, 10);
+        default:
+            return 0;
+    }
+}
+
+double Value::asDouble() const {
+    switch (type_) {
+        case Integer:
+            return static_cast<double>(integer_);
+        case Float:
+            return float_;
+        case Text:
+            return std::strtod(bytes_.c_str(), nullptr);
+        default:
+            return 0.0;
+    }
+}
+
+std::string Value::asString() const {
+    switch (type_) {
+        case Integer:
+            return std::to_string(integer_);
+        case Float: {
+            // match SQLite's own float to text conversion
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.15g", float_);
+            std::string text(buffer);
+            if (text.find_first_of(".eEn") == std::string::npos) {
+                text += ".0";
+            }
+            return text;
+        }
+        case Text:
+        case Blob:
+            return bytes_;
+        default:
+            return std::string();
+    }
+}
+
+} /* namespace sqlite */
@@ -0,0 +1,482 @@
+/*
+ * File:   VirtualTable.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include <SQLiteDatabase.h>
+#include "VirtualTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+namespace sqlite {
+
+namespace {
+
+/** Constraint pushed down by xBestIndex, argument holds the right hand side passed to xFilter. */
+struct Constraint {
+    int column;
+    unsigned char op;
+    Value argument;
+};
+
+struct Table {
+    sqlite3_vtab base;
+    VirtualTableBase* table;
+};
+
+struct TableCursor {
+    sqlite3_vtab_cursor base;
+    std::size_t row;
+    std::size_t end;
+    std::vector<Constraint> constraints;
+};
+
+/** Sort class of a value in SQLite's order, NULL < numeric < text < blob. */
+int storageClass(const Value& value) {
+    switch (value.type()) {
+        case Value::Integer:
+        case Value::Float:
+            return 1;
+        case Value::Text:
+            return 2;
+        case Value::Blob:
+            return 3;
+        default:
+            return 0;
+    }
+}
+
+/** Compares an integer with a real exactly, converting either one would round above 2^53. */
+int compareIntegerReal(const long long integer, const double real) {
+    // 2^63, the first double past the int64 range, NaN is left unordered like SQLite does with NULL
+    const double limit = 9223372036854775808.0;
+    if (std::isnan(real) || real < -limit) {
+        return 1;
+    }
+    if (real >= limit) {
+        return -1;
+    }
+
+    auto truncated = static_cast<long long>(real);
+    if (integer != truncated) {
+        return integer < truncated ? -1 : 1;
+    }
+
+    // equal integer parts, the fraction decides
+    auto whole = std::trunc(real);
+    return real > whole ? -1 : (real < whole ? 1 : 0);
+}
+
+/** Compares two values of the same storage class with BINARY collation. */
+int compareValues(const Value& left, const Value& right) {
+    if (storageClass(left) == 1) {
+        auto leftInteger = left.type() == Value::Integer;
+        auto rightInteger = right.type() == Value::Integer;
+
+        if (leftInteger && rightInteger) {
+            return left.asInt64() < right.asInt64() ? -1 : (left.asInt64() > right.asInt64() ? 1 : 0);
+        }
+        if (leftInteger) {
+            return compareIntegerReal(left.asInt64(), right.asDouble());
+        }
+        if (rightInteger) {
+            return -compareIntegerReal(right.asInt64(), left.asDouble());
+        }
+        return left.asDouble() < right.asDouble() ? -1 : (left.asDouble() > right.asDouble() ? 1 : 0);
+    }
+    return left.bytes().compare(right.bytes());
+}
+
+/** Compares in SQLite's sort order, used to search the sorted column. */
+int compareOrdered(const Value& left, const Value& right) {
+    auto leftClass = storageClass(left);
+    auto rightClass = storageClass(right);
+
+    if (leftClass != rightClass) {
+        return leftClass < rightClass ? -1 : 1;
+    }
+    return leftClass == 0 ? 0 : compareValues(left, right);
+}
+
+bool satisfies(const int comparison, const unsigned char op) {
+    switch (op) {
+        case SQLITE_INDEX_CONSTRAINT_EQ:
+            return comparison == 0;
+        case SQLITE_INDEX_CONSTRAINT_GT:
+            return comparison > 0;
+        case SQLITE_INDEX_CONSTRAINT_GE:
+            return comparison >= 0;
+        case SQLITE_INDEX_CONSTRAINT_LT:
+            return comparison < 0;
+        case SQLITE_INDEX_CONSTRAINT_LE:
+            return comparison <= 0;
+        default:
+            return true;
+    }
+}
+
+bool isPushable(const unsigned char op) {
+    return op == SQLITE_INDEX_CONSTRAINT_EQ || op == SQLITE_INDEX_CONSTRAINT_GT || op == SQLITE_INDEX_CONSTRAINT_GE ||
+           op == SQLITE_INDEX_CONSTRAINT_LT || op == SQLITE_INDEX_CONSTRAINT_LE;
+}
+
+/** Only BINARY comparisons are checked in C++, others are left to SQLite. */
+bool isBinaryCollation(sqlite3_index_info* info, const int constraint) {
+#if SQLITE_VERSION_NUMBER >= 3022000
+    auto collation = sqlite3_vtab_collation(info, constraint);
+    return collation == nullptr || sqlite3_stricmp(collation, "BINARY") == 0;
+#else
+    (void)info;
+    (void)constraint;
+    return true;
+#endif
+}
+
+int setError(sqlite3_vtab* vtab, const char* message) {
+    sqlite3_free(vtab->zErrMsg);
+    vtab->zErrMsg = sqlite3_mprintf("%s", message);
+    return SQLITE_ERROR;
+}
+
+} /* namespace */
+
+/** sqlite3_module callbacks, a friend of VirtualTableBase. */
+struct VirtualTableModule {
+    static int connect(sqlite3* db, void* aux, int, const char* const*, sqlite3_vtab** vtab, char** error) {
+        auto table = static_cast<VirtualTableBase*>(aux);
+
+        auto rc = sqlite3_declare_vtab(db, table->getSchema().c_str());
+        if (rc != SQLITE_OK) {
+            *error = sqlite3_mprintf("%s", sqlite3_errmsg(db));
+            return rc;
+        }
+
+        auto result = new (std::nothrow) Table();
+        if (result == nullptr) {
+            return SQLITE_NOMEM;
+        }
+        result->table = table;
+        *vtab = &result->base;
+        return SQLITE_OK;
+    }
+
+    static int disconnect(sqlite3_vtab* vtab) {
+        delete reinterpret_cast<Table*>(vtab);
+        return SQLITE_OK;
+    }
+
+    static int bestIndex(sqlite3_vtab* vtab, sqlite3_index_info* info) {
+        auto table = reinterpret_cast<Table*>(vtab)->table;
+        auto rows = static_cast<double>(table->size());
+        auto cost = rows;
+        auto estimatedRows = rows;
+        auto argument = 0;
+        std::ostringstream plan;
+
+        for (auto ii = 0; ii < info->nConstraint; ii++) {
+            auto& constraint = info->aConstraint[ii];
+            if (!constraint.usable || !isPushable(constraint.op) || !isBinaryCollation(info, ii)) {
+                continue;
+            }
+
+            auto narrows = constraint.iColumn < 0 || constraint.iColumn == table->sortedColumn_;
+            auto equality = constraint.op == SQLITE_INDEX_CONSTRAINT_EQ;
+
+            if (narrows) {
+                // lookups and binary searches cut the scan itself
+                estimatedRows = equality ? (constraint.iColumn < 0 ? 1 : estimatedRows / 10) : estimatedRows / 4;
+                cost = std::log2(rows + 1) + estimatedRows;
+            }
+            else {
+                // checked in C++ while scanning, saves SQLite reading the columns of rejected rows
+                estimatedRows = equality ? estimatedRows / 10 : estimatedRows / 3;
+                cost = cost * 0.9;
+            }
+
+            if (equality && constraint.iColumn < 0) {
+                info->idxFlags |= SQLITE_INDEX_SCAN_UNIQUE;
+            }
+
+            info->aConstraintUsage[ii].argvIndex = ++argument;
+            plan << constraint.iColumn << ' ' << static_cast<int>(constraint.op) << ' ';
+        }
+
+        if (info->nOrderBy == 1 && !info->aOrderBy[0].desc &&
+            (info->aOrderBy[0].iColumn < 0 || info->aOrderBy[0].iColumn == table->sortedColumn_)) {
+            info->orderByConsumed = 1;
+        }
+
+        info->estimatedCost = cost < 1 ? 1 : cost;
+        info->estimatedRows = static_cast<sqlite3_int64>(estimatedRows < 1 ? 1 : estimatedRows);
+        info->idxStr = sqlite3_mprintf("%s", plan.str().c_str());
+        info->needToFreeIdxStr = 1;
+
+        return info->idxStr == nullptr ? SQLITE_NOMEM : SQLITE_OK;
+    }
+
+    static int open(sqlite3_vtab* vtab, sqlite3_vtab_cursor** cursor) {
+        auto result = new (std::nothrow) TableCursor();
+        if (result == nullptr) {
+            return SQLITE_NOMEM;
+        }
+        result->row = 0;
+        result->end = 0;
+        reinterpret_cast<Table*>(vtab)->table->rowsScanned_ = 0;
+        *cursor = &result->base;
+        return SQLITE_OK;
+    }
+
+    static int close(sqlite3_vtab_cursor* cursor) {
+        delete reinterpret_cast<TableCursor*>(cursor);
+        return SQLITE_OK;
+    }
+
+    static bool matches(VirtualTableBase& table, TableCursor& cursor) {
+        for (auto& constraint : cursor.constraints) {
+            if (constraint.column < 0) {
+                continue;
+            }
+
+            auto value = table.value(cursor.row, constraint.column);
+            if (storageClass(value) == 0 || storageClass(constraint.argument) == 0) {
+                // NULL never compares true
+                return false;
+            }
+            // a type mismatch may still match after affinity conversion, let SQLite decide
+            if (storageClass(value) == storageClass(constraint.argument) &&
+                !satisfies(compareValues(value, constraint.argument), constraint.op)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void skipRejected(VirtualTableBase& table, TableCursor& cursor) {
+        while (cursor.row < cursor.end) {
+            table.rowsScanned_++;
+            if (matches(table, cursor)) {
+                return;
+            }
+            cursor.row++;
+        }
+    }
+
+    /** First row in [begin, end) of the sorted column whose value is not before argument, or after it if after is
+     * set. */
+    static std::size_t search(VirtualTableBase& table, const int column, std::size_t begin, std::size_t end,
+                              const Value& argument, const bool after) {
+        while (begin < end) {
+            auto middle = begin + (end - begin) / 2;
+            auto comparison = compareOrdered(table.value(middle, column), argument);
+            if (comparison < 0 || (after && comparison == 0)) {
+                begin = middle + 1;
+            }
+            else {
+                end = middle;
+            }
+        }
+        return begin;
+    }
+
+    static void narrow(VirtualTableBase& table, TableCursor& cursor, const Constraint& constraint) {
+        auto& argument = constraint.argument;
+        auto begin = cursor.row;
+        auto end = cursor.end;
+
+        if (constraint.column < 0) {
+            if (argument.type() != Value::Integer) {
+                return;
+            }
+            auto rowid = argument.asInt64();
+            auto clamp = [end](long long row) {
+                return row < 0 ? std::size_t(0)
+                               : (static_cast<unsigned long long>(row) > end ? end : static_cast<std::size_t>(row));
+            };
+            // no row is past LLONG_MAX, clamping it gives end just like the row after it would
+            auto next = rowid < std::numeric_limits<long long>::max() ? rowid + 1 : rowid;
+
+            switch (constraint.op) {
+                case SQLITE_INDEX_CONSTRAINT_EQ:
+                    begin = std::max(begin, clamp(rowid));
+                    end = std::min(end, clamp(next));
+                    break;
+                case SQLITE_INDEX_CONSTRAINT_GT:
+                    begin = std::max(begin, clamp(next));
+                    break;
+                case SQLITE_INDEX_CONSTRAINT_GE:
+                    begin = std::max(begin, clamp(rowid));
+                    break;
+                case SQLITE_INDEX_CONSTRAINT_LT:
+                    end = std::min(end, clamp(rowid));
+                    break;
+                case SQLITE_INDEX_CONSTRAINT_LE:
+                    end = std::min(end, clamp(next));
+                    break;
+            }
+        }
+        else {
+            auto affinity = table.columns_[constraint.column].affinity;
+            auto argumentClass = storageClass(argument);
+            if (!((affinity == VirtualTableBase::NumericAffinity && argumentClass == 1) ||
+                  (affinity == VirtualTableBase::TextAffinity && argumentClass == 2))) {
+                return;
+            }
+
+            auto column = constraint.column;
+            switch (constraint.op) {
+                case SQLITE_INDEX_CONSTRAINT_EQ:
+                    begin = search(table, column, begin, end, argument, false);
+                    end = search(table, column, begin, end, argument, true);
+                    break;
+                case SQLITE_INDEX_CONSTRAINT_GT:
+                    begin = search(table, column, begin, end, argument, true);
+                    break;
+                case SQLITE_INDEX_CONSTRAINT_GE:
+                    begin = search(table, column, begin, end, argument, false);
+                    break;
+                case SQLITE_INDEX_CONSTRAINT_LT:
+                    end = search(table, column, begin, end, argument, false);
+                    break;
+                case SQLITE_INDEX_CONSTRAINT_LE:
+                    end = search(table, column, begin, end, argument, true);
+                    break;
+            }
+        }
+
+        cursor.row = begin;
+        cursor.end = end < begin ? begin : end;
+    }
+
+    static int filter(sqlite3_vtab_cursor* vtabCursor, int, const char* idxStr, int argc, sqlite3_value** argv) {
+        auto& cursor = *reinterpret_cast<TableCursor*>(vtabCursor);
+        auto& table = *reinterpret_cast<Table*>(vtabCursor->pVtab)->table;
+
+        try {
+            cursor.constraints.clear();
+            cursor.row = 0;
+            cursor.end = table.size();
+
+            std::istringstream plan(idxStr == nullptr ? "" : idxStr);
+            for (auto ii = 0; ii < argc; ii++) {
+                Constraint constraint;
+                int op = 0;
+                plan >> constraint.column >> op;
+                constraint.op = static_cast<unsigned char>(op);
+                constraint.argument = ArgumentReader<Value>::read(argv[ii]);
+                cursor.constraints.push_back(constraint);
+            }
+
+            for (auto& constraint : cursor.constraints) {
+                if (constraint.column < 0 || constraint.column == table.sortedColumn_) {
+                    narrow(table, cursor, constraint);
+                }
+            }
+
+            skipRejected(table, cursor);
+        }
+        catch (const std::exception& e) {
+            return setError(vtabCursor->pVtab, e.what());
+        }
+        return SQLITE_OK;
+    }
+
+    static int next(sqlite3_vtab_cursor* vtabCursor) {
+        auto& cursor = *reinterpret_cast<TableCursor*>(vtabCursor);
+
+        try {
+            cursor.row++;
+            skipRejected(*reinterpret_cast<Table*>(vtabCursor->pVtab)->table, cursor);
+        }
+        catch (const std::exception& e) {
+            return setError(vtabCursor->pVtab, e.what());
+        }
+        return SQLITE_OK;
+    }
+
+    static int eof(sqlite3_vtab_cursor* vtabCursor) {
+        auto& cursor = *reinterpret_cast<TableCursor*>(vtabCursor);
+        return cursor.row >= cursor.end ? 1 : 0;
+    }
+
+    static int column(sqlite3_vtab_cursor* vtabCursor, sqlite3_context* context, int column) {
+        auto& cursor = *reinterpret_cast<TableCursor*>(vtabCursor);
+
+        try {
+            reinterpret_cast<Table*>(vtabCursor->pVtab)->table->result(cursor.row, column, context);
+        }
+        catch (...) {
+            detail::setError(context, std::current_exception());
+        }
+        return SQLITE_OK;
+    }
+
+    static int rowid(sqlite3_vtab_cursor* vtabCursor, sqlite3_int64* rowid) {
+        *rowid = static_cast<sqlite3_int64>(reinterpret_cast<TableCursor*>(vtabCursor)->row);
+        return SQLITE_OK;
+    }
+};
+
+VirtualTableBase::VirtualTableBase() : sortedColumn_(-1), rowsScanned_(0) {
+}
+
+VirtualTableBase::~VirtualTableBase() {
+}
+
+void VirtualTableBase::sortedBy(const std::string& column) {
+    for (std::size_t ii = 0; ii < columns_.size(); ii++) {
+        if (columns_[ii].name == column) {
+            sortedColumn_ = static_cast<int>(ii);
+            return;
+        }
+    }
+
+    throw SQLiteDatabaseException("Virtual table has no column " + column);
+}
+
+std::string VirtualTableBase::getSchema() const {
+    std::string schema = "CREATE TABLE x(";
+
+    for (std::size_t ii = 0; ii < columns_.size(); ii++) {
+        schema += "\"" + columns_[ii].name + "\"";
+        if (!columns_[ii].type.empty()) {
+            schema += " " + columns_[ii].type;
+        }
+        schema += (ii < columns_.size() - 1 ? ", " : ")");
+    }
+
+    return schema;
+}
+
+const sqlite3_module* VirtualTableBase::module() {
+    static const sqlite3_module module = [] {
+        sqlite3_module result;
+        std::memset(&result, 0, sizeof(result));
+
+        // no xUpdate, the table is read only
+        result.iVersion = 1;
+        result.xCreate = &VirtualTableModule::connect;
+        result.xConnect = &VirtualTableModule::connect;
+        result.xBestIndex = &VirtualTableModule::bestIndex;
+        result.xDisconnect = &VirtualTableModule::disconnect;
+        result.xDestroy = &VirtualTableModule::disconnect;
+        result.xOpen = &VirtualTableModule::open;
+        result.xClose = &VirtualTableModule::close;
+        result.xFilter = &VirtualTableModule::filter;
+        result.xNext = &VirtualTableModule::next;
+        result.xEof = &VirtualTableModule::eof;
+        result.xColumn = &VirtualTableModule::column;
+        result.xRowid = &VirtualTableModule::rowid;
+        return result;
+    }();
+
+    return &module;
+}
+
+} /* namespace sqlite */
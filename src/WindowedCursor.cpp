@@ -0,0 +1,193 @@
+/*
+ * File:   WindowedCursor.cpp
+ * Author: Matthew Landowski <matthew.landowski@gmail.com>
+ *
+ * Created on October 18, 2026
+ */
+
+#include <SQLiteDatabase.h>
+#include "WindowedCursor.h"
+
+namespace sqlite {
+
+const std::size_t WindowedCursor::kDefaultWindowSize;
+
+WindowedCursor::WindowedCursor(SQLiteDatabase& db, const std::string& table, const std::vector<std::string>& columns,
+                               const std::string& selection, const std::vector<Value>& selectionArgs,
+                               const std::size_t windowSize)
+        : db_(&db),
+          selectionArgs_(selectionArgs),
+          windowSize_(windowSize == 0 ? kDefaultWindowSize : windowSize),
+          windowStart_(0),
+          windowFills_(0),
+          pos_(-1),
+          count_(-1) {
+
+    // the rowid is read as a hidden first column so the next window can continue after it
+    std::string select = "SELECT rowid AS window_rowid_";
+
+    if (columns.size() == 0) {
+        select += ", *";
+    }
+    else {
+        for (auto& column : columns) {
+            select += ", " + column;
+        }
+    }
+
+    select += " FROM " + table + " WHERE ";
+
+    std::string where = selection.empty() ? "" : "(" + selection + ") AND ";
+
+    // the sql only depends on the table and selection so every window reuses the cached statements
+    keysetSql_ = select + where + "rowid > ? ORDER BY rowid LIMIT ?";
+    offsetSql_ = select + (selection.empty() ? "1" : selection) + " ORDER BY rowid LIMIT ? OFFSET ?";
+    countSql_ = "SELECT COUNT(*) FROM " + table + (selection.empty() ? "" : " WHERE " + selection);
+
+    window_ = fetchWindow(0);
+
+    auto& names = window_.getColumnsNames();
+    for (std::size_t col = 1; col < names.size(); col++) {
+        columnNames.push_back(names[col]);
+        columnNamesIndexMap[names[col]] = static_cast<int>(col) - 1;
+    }
+}
+
+WindowedCursor::~WindowedCursor() {
+}
+
+bool WindowedCursor::next() {
+    return moveToPosition(pos_ + 1);
+}
+
+bool WindowedCursor::moveToPosition(const long long position) {
+    // like Cursor a failed move leaves the cursor on its row
+    if (position < 0 || (count_ >= 0 && position >= count_)) {
+        return false;
+    }
+
+    if (position < windowStart_ || position >= windowStart_ + window_.getCount()) {
+        auto windowStart = position - position % static_cast<long long>(windowSize_);
+        auto window = fetchWindow(windowStart);
+
+        if (position >= windowStart + window.getCount()) {
+            return false;
+        }
+
+        window_ = window;
+        windowStart_ = windowStart;
+    }
+
+    window_.moveToPosition(static_cast<int>(position - windowStart_));
+    pos_ = position;
+
+    return true;
+}
+
+long long WindowedCursor::getCount() {
+    if (count_ < 0) {
+        auto c = db_->rawQuery(countSql_, selectionArgs_);
+        c.next();
+        count_ = c.getLong(1);
+    }
+
+    return count_;
+}
+
+Cursor WindowedCursor::fetchWindow(const long long windowStart) {
+    std::vector<Value> args(selectionArgs_);
+
+    auto key = windowKeys_.find(windowStart);
+
+    Cursor window;
+    if (key != windowKeys_.end()) {
+        args.push_back(Value(key->second));
+        args.push_back(Value(static_cast<long long>(windowSize_)));
+        window = db_->rawQuery(keysetSql_, args);
+    }
+    else {
+        args.push_back(Value(static_cast<long long>(windowSize_)));
+        args.push_back(Value(windowStart));
+        window = db_->rawQuery(offsetSql_, args);
+    }
+
+    windowFills_++;
+
+    auto rows = window.getCount();
+
+    if (rows > 0) {
+        // remember where the following window starts
+        window.moveToPosition(rows - 1);
+        windowKeys_[windowStart + rows] = window.getLong(1);
+    }
+
+    // a short window is the end of the result set
+    if (static_cast<std::size_t>(rows) < windowSize_ && (rows > 0 || key != windowKeys_.end() || windowStart == 0)) {
+        count_ = windowStart + rows;
+    }
+
+    return window;
+}
+
+int WindowedCursor::windowColumn(const int columnIndex) const {
+    if (columnIndex < 1 || static_cast<std::size_t>(columnIndex) > columnNames.size()) {
+        throw SQLiteDatabaseException("Invalid column index");
+    }
+
+    if (pos_ < windowStart_ || pos_ >= windowStart_ + window_.getCount()) {
+        throw SQLiteDatabaseException("Cursor is not positioned on a row");
+    }
+
+    // skip the hidden rowid column
+    return columnIndex + 1;
+}
+
+int WindowedCursor::getColumnIndex(const std::string& columnName) const {
+    return columnNamesIndexMap.at(columnName);
+}
+
+std::string WindowedCursor::getString(const int columnIndex) const {
+    return window_.getString(windowColumn(columnIndex));
+}
+
+std::string WindowedCursor::getString(const std::string& columnName) const {
+    return getString(getColumnIndex(columnName) + 1);
+}
+
+ByteView WindowedCursor::getStringView(const int columnIndex) const {
+    return window_.getStringView(windowColumn(columnIndex));
+}
+
+int WindowedCursor::getInt(const int columnIndex) const {
+    return window_.getInt(windowColumn(columnIndex));
+}
+
+int WindowedCursor::getInt(const std::string& columnName) const {
+    return getInt(getColumnIndex(columnName) + 1);
+}
+
+double WindowedCursor::getDouble(const int columnIndex) const {
+    return window_.getDouble(windowColumn(columnIndex));
+}
+
+double WindowedCursor::getDouble(const std::string& columnName) const {
+    return getDouble(getColumnIndex(columnName) + 1);
+}
+
+long WindowedCursor::getLong(const int columnIndex) const {
+    return window_.getLong(windowColumn(columnIndex));
+}
+
+long WindowedCursor::getLong(const std::string& columnName) const {
+    return getLong(getColumnIndex(columnName) + 1);
+}
+
+bool WindowedCursor::isNull(const int columnIndex) const {
+    return window_.isNull(windowColumn(columnIndex));
+}
+
+Value::Type WindowedCursor::getType(const int columnIndex) const {
+    return window_.getType(windowColumn(columnIndex));
+}
+
+} /* namespace sqlite */
@@ -1,14 +1,18 @@
 #include <gtest/gtest.h>
 #include "../../include/SQLiteDatabase.h"
+#include "../../include/SQLiteAsyncDatabase.h"
+#include "../../include/SQLiteWriteQueue.h"
+#include "../../include/Transaction.h"
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <vector>
 #include <thread> // for multithreaded unit test
 
 bool fexists(const std::string& filename) {
   std::ifstream ifile(filename.c_str());
-  return ifile;
+  return ifile.good();
 };
 
 class SQLiteDatabaseTestFixture : public ::testing::Test {
@@ -234,6 +238,368 @@ TEST_F(SQLiteDatabaseTestFixture, remove_test) {
     }
 }
 
+TEST_F(SQLiteDatabaseTestFixture, statement_cache_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (mpg text, weight text)");
+
+    const std::string table = "cars";
+    for (auto ii = 0; ii < 10; ii++) {
+        db.insert(table, std::vector<std::string>{"mpg", "weight"}, std::vector<std::string>{"34", "2000"}, "",
+                  std::vector<std::string>{});
+    }
+
+    // first insert prepares, the rest reuse the cached statement
+    EXPECT_EQ(db.getStatementCache().misses(), 1u);
+    EXPECT_EQ(db.getStatementCache().hits(), 9u);
+
+    for (auto ii = 0; ii < 5; ii++) {
+        auto c = db.query(false, table, std::vector<std::string>{"mpg"}, "weight = ?",
+                          std::vector<std::string>{"2000"}, "", "", "");
+        EXPECT_EQ(c.getCount(), 10);
+    }
+
+    EXPECT_EQ(db.getStatementCache().misses(), 2u);
+    EXPECT_EQ(db.getStatementCache().hits(), 13u);
+    EXPECT_EQ(db.getStatementCache().size(), 2u);
+
+    // shrinking the cache evicts the least recently used statements
+    db.setMaxSqlCacheSize(1);
+    EXPECT_EQ(db.getStatementCache().size(), 1u);
+
+    db.setMaxSqlCacheSize(0);
+    EXPECT_EQ(db.getStatementCache().size(), 0u);
+    db.getVersion();
+    EXPECT_EQ(db.getStatementCache().size(), 0u);
+
+    db.setMaxSqlCacheSize(sqlite::StatementCache::kDefaultCapacity);
+    db.getVersion();
+    EXPECT_EQ(db.getStatementCache().size(), 1u);
+
+    // cached statements must not keep the connection from closing
+    EXPECT_NO_THROW(db.close());
+    EXPECT_EQ(db.getStatementCache().size(), 0u);
+}
+
+TEST_F(SQLiteDatabaseTestFixture, streaming_query_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (mpg integer, weight integer)");
+    db.execQuery("INSERT INTO cars VALUES(34, 2000)");
+    db.execQuery("INSERT INTO cars VALUES(27, 25000)");
+    db.execQuery("INSERT INTO cars VALUES(16, 5000)");
+
+    {
+        auto c = db.queryStreaming(false, "cars", std::vector<std::string>{"mpg", "weight"}, "weight > ?",
+                                   std::vector<std::string>{"3000"}, "", "mpg", "");
+
+        EXPECT_THROW(c.getInt(1), sqlite::SQLiteDatabaseException);
+
+        ASSERT_TRUE(c.next());
+        EXPECT_EQ(c.getInt(1), 16);
+        EXPECT_EQ(c.getLong("weight"), 5000);
+        ASSERT_TRUE(c.next());
+        EXPECT_STREQ(c.getString(1).c_str(), "27");
+        EXPECT_EQ(c.getPosition(), 2);
+
+        EXPECT_FALSE(c.next());
+        EXPECT_TRUE(c.isDone());
+        EXPECT_FALSE(c.next());
+    }
+
+    // an abandoned cursor hands its statement back to the cache
+    {
+        auto c = db.queryStreaming("SELECT mpg FROM cars");
+        ASSERT_TRUE(c.next());
+    }
+    auto c = db.queryStreaming("SELECT mpg FROM cars");
+    EXPECT_EQ(db.getStatementCache().hits(), 1u);
+    c.close();
+
+    EXPECT_NO_THROW(db.close());
+}
+
+TEST_F(SQLiteDatabaseTestFixture, typed_cursor_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (make text, mpg integer, weight real, notes text)");
+    db.execQuery("INSERT INTO cars VALUES('Ford', 27, 2000.5, NULL)");
+    db.execQuery("INSERT INTO cars VALUES('Tesla', 8589934592, 3000, 'electric')");
+
+    auto c = db.query("SELECT make, mpg, weight, notes FROM cars");
+    ASSERT_EQ(c.getCount(), 2);
+
+    c.next();
+    EXPECT_EQ(c.getType(1), sqlite::Value::Text);
+    EXPECT_EQ(c.getType(2), sqlite::Value::Integer);
+    EXPECT_EQ(c.getType(3), sqlite::Value::Float);
+    EXPECT_EQ(c.getInt(2), 27);
+    EXPECT_DOUBLE_EQ(c.getDouble("weight"), 2000.5);
+    EXPECT_TRUE(c.isNull(4));
+    EXPECT_TRUE(c.getString("notes").empty());
+    EXPECT_FALSE(c.isNull("make"));
+
+    c.next();
+    EXPECT_EQ(c.getLong("mpg"), 8589934592L);
+    EXPECT_STREQ(c.getString(2).c_str(), "8589934592");
+    EXPECT_STREQ(c.getString(3).c_str(), "3000.0");
+    EXPECT_STREQ(c.getString(4).c_str(), "electric");
+
+    EXPECT_THROW(c.getInt(5), sqlite::SQLiteDatabaseException);
+    EXPECT_THROW(c.getInt(0), sqlite::SQLiteDatabaseException);
+
+    db.close();
+}
+
+TEST_F(SQLiteDatabaseTestFixture, bound_insert_update_remove_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (make text, mpg integer, weight real, photo blob)");
+
+    const std::string table = "cars";
+    const std::vector<std::string> columns{"make", "mpg", "weight", "photo"};
+    const char photo[] = {'\x89', 'P', '\0', 'G'};
+
+    auto id = db.insert(table, columns, std::vector<sqlite::Value>{"Ford", 27, 2000.5, sqlite::Value::blob(photo, 4)});
+    auto id2 = db.insert(table, columns, std::vector<sqlite::Value>{"Tesla", 0, 3000.0, sqlite::Value()});
+    auto id3 = db.insert(table, columns, std::vector<sqlite::Value>{"Toyota", 40, 2600.0, sqlite::Value()});
+
+    EXPECT_EQ(id, 1);
+    EXPECT_EQ(id2, 2);
+    EXPECT_EQ(id3, 3);
+
+    // every row uses the same sql so only the first insert prepares
+    EXPECT_EQ(db.getStatementCache().misses(), 1u);
+    EXPECT_EQ(db.getStatementCache().hits(), 2u);
+
+    auto updated_rows = db.update(table, std::vector<std::string>{"mpg"}, std::vector<sqlite::Value>{45},
+                                  "make = ?", std::vector<sqlite::Value>{"Toyota"});
+    EXPECT_EQ(updated_rows, 1);
+
+    auto c = db.query("SELECT make, mpg, weight, photo FROM cars ORDER BY rowid");
+    c.next();
+    EXPECT_EQ(c.getType(2), sqlite::Value::Integer);
+    EXPECT_EQ(c.getType(4), sqlite::Value::Blob);
+    EXPECT_EQ(c.getValue(4).bytes(), std::string(photo, 4));
+    c.next();
+    EXPECT_TRUE(c.isNull(4));
+    c.next();
+    EXPECT_EQ(c.getInt("mpg"), 45);
+
+    auto deleted_rows = db.remove(table, "mpg < ?", std::vector<sqlite::Value>{30});
+    EXPECT_EQ(deleted_rows, 2);
+
+    EXPECT_THROW(db.insert(table, columns, std::vector<sqlite::Value>{"Ford"}), sqlite::SQLiteDatabaseException);
+
+    db.close();
+}
+
+TEST_F(SQLiteDatabaseTestFixture, insert_many_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (mpg integer, weight integer)");
+
+    const std::string table = "cars";
+    const std::vector<std::string> columns{"mpg", "weight"};
+
+    std::vector<std::vector<sqlite::Value>> rows;
+    for (auto ii = 0; ii < 25; ii++) {
+        rows.push_back(std::vector<sqlite::Value>{ii, ii * 100});
+    }
+
+    EXPECT_EQ(db.insertMany(table, columns, rows, 10), 25);
+
+    // generator rows, a bad row rolls back its batch and keeps the committed batches
+    int next = 0;
+    EXPECT_THROW(db.insertMany(table, columns, [&next](std::vector<sqlite::Value>& row) {
+        if (next == 15) {
+            row.push_back(sqlite::Value(1));
+        } else {
+            row.push_back(sqlite::Value(next));
+            row.push_back(sqlite::Value(next));
+        }
+        next++;
+        return true;
+    }, 10), sqlite::SQLiteDatabaseException);
+
+    auto c = db.query("SELECT COUNT(*), SUM(weight) FROM cars");
+    c.next();
+    EXPECT_EQ(c.getInt(1), 35);
+
+    // inside a caller transaction nothing is committed until the caller commits
+    db.beginTransaction();
+    EXPECT_EQ(db.insertMany(table, columns, rows, 10), 25);
+    db.rollback();
+
+    c = db.query("SELECT COUNT(*) FROM cars");
+    c.next();
+    EXPECT_EQ(c.getInt(1), 35);
+
+    db.close();
+}
+
+TEST_F(SQLiteDatabaseTestFixture, cursor_arena_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (make text, model text, mpg integer)");
+    db.execQuery("INSERT INTO cars VALUES('Ford', 'Focus', 34)");
+    db.execQuery("INSERT INTO cars VALUES('Tesla', '', 0)");
+    db.execQuery("INSERT INTO cars VALUES(NULL, 'x''y', 27)");
+
+    auto c = db.query("SELECT make, model, mpg FROM cars ORDER BY rowid");
+
+    // every text cell and its terminator lives in one buffer
+    EXPECT_EQ(c.getByteSize(), std::string("Ford").size() + std::string("Focus").size() + std::string("Tesla").size()
+                               + std::string("x'y").size() + 5);
+
+    ASSERT_TRUE(c.next());
+    EXPECT_TRUE(c.getStringView(1) == std::string("Ford"));
+    EXPECT_TRUE(c.getStringView("model") == std::string("Focus"));
+    EXPECT_TRUE(c.getStringView(3).empty());
+
+    ASSERT_TRUE(c.next());
+    EXPECT_TRUE(c.getStringView(2).empty());
+    EXPECT_FALSE(c.isNull(2));
+
+    ASSERT_TRUE(c.next());
+    EXPECT_TRUE(c.isNull(1));
+    EXPECT_EQ(c.getStringView(2).str(), "x'y");
+    EXPECT_EQ(c.getInt(3), 27);
+
+    // copies own their own arena
+    sqlite::Cursor copy = c;
+    c.reset();
+    EXPECT_EQ(copy.getString(2), "x'y");
+
+    EXPECT_FALSE(copy.next());
+
+    db.close();
+}
+
+struct Car {
+    std::string make;
+    int mpg;
+    double weight;
+};
+
+namespace sqlite {
+template <>
+struct RowMapper<Car> {
+    typedef std::tuple<std::string, int, double> Columns;
+    static Car map(std::string make, int mpg, double weight) { return Car{make, mpg, weight}; }
+};
+} /* namespace sqlite */
+
+TEST_F(SQLiteDatabaseTestFixture, typed_query_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (make text, mpg integer, weight real)");
+    db.execQuery("INSERT INTO cars VALUES('Ford', 27, 2000.5)");
+    db.execQuery("INSERT INTO cars VALUES('Tesla', 0, 3000)");
+    db.execQuery("INSERT INTO cars VALUES('Toyota', 40, 2600)");
+
+    auto rows = db.query<long long, double, std::string>("SELECT mpg, weight, make FROM cars WHERE weight > ? "
+                                                         "ORDER BY weight", std::vector<sqlite::Value>{2500});
+    ASSERT_EQ(rows.size(), 2u);
+    EXPECT_EQ(std::get<0>(rows[0]), 40);
+    EXPECT_DOUBLE_EQ(std::get<1>(rows[0]), 2600.0);
+    EXPECT_EQ(std::get<2>(rows[1]), "Tesla");
+
+    auto cars = db.queryAs<Car>("SELECT make, mpg, weight FROM cars ORDER BY mpg");
+    ASSERT_EQ(cars.size(), 3u);
+    EXPECT_EQ(cars[0].make, "Tesla");
+    EXPECT_EQ(cars[2].mpg, 40);
+    EXPECT_DOUBLE_EQ(cars[1].weight, 2000.5);
+
+    // the column count is checked against the requested types
+    EXPECT_THROW((db.query<int, int>("SELECT mpg FROM cars", std::vector<sqlite::Value>())),
+                 sqlite::SQLiteDatabaseException);
+    EXPECT_THROW(db.queryAs<Car>("SELECT make, mpg FROM cars"), sqlite::SQLiteDatabaseException);
+
+    db.close();
+}
+
+TEST_F(SQLiteDatabaseTestFixture, windowed_cursor_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (mpg integer, weight integer)");
+
+    std::vector<std::vector<sqlite::Value>> rows;
+    for (auto ii = 0; ii < 1000; ii++) {
+        rows.push_back(std::vector<sqlite::Value>{ii % 50, ii});
+    }
+    db.insertMany("cars", std::vector<std::string>{"mpg", "weight"}, rows);
+
+    auto c = db.queryWindowed("cars", std::vector<std::string>{"weight", "mpg"}, "mpg < ?",
+                              std::vector<sqlite::Value>{10}, 32);
+
+    ASSERT_EQ(c.getColumnsNames().size(), 2u);
+    EXPECT_EQ(c.getColumnsNames()[0], "weight");
+
+    // sequential scan crosses window boundaries
+    long long seen = 0;
+    while (c.next()) {
+        EXPECT_LT(c.getInt("mpg"), 10);
+        EXPECT_EQ(c.getLong(1) % 50, c.getInt(2));
+        seen++;
+    }
+    EXPECT_EQ(seen, 200);
+    EXPECT_EQ(c.getWindowFills(), 7u);
+
+    // the count is known once the end has been reached
+    EXPECT_EQ(c.getCount(), 200);
+
+    // random access refills the window holding the row
+    ASSERT_TRUE(c.moveToPosition(15));
+    EXPECT_EQ(c.getLong(1), 55);
+    ASSERT_TRUE(c.moveToPosition(199));
+    EXPECT_EQ(c.getLong(1), 959);
+    // like Cursor a failed move keeps the current row
+    EXPECT_FALSE(c.moveToPosition(200));
+    EXPECT_EQ(c.getPosition(), 199);
+    EXPECT_EQ(c.getLong(1), 959);
+
+    // getCount is computed lazily for cursors that have not reached the end
+    auto lazy = db.queryWindowed("cars", std::vector<std::string>(), "", std::vector<sqlite::Value>(), 100);
+    ASSERT_TRUE(lazy.moveToPosition(750));
+    EXPECT_EQ(lazy.getLong("weight"), 750);
+    EXPECT_EQ(lazy.getWindowStart(), 700);
+
+    // a move past the end found by a refill doesn't drop the current window
+    EXPECT_FALSE(lazy.moveToPosition(1050));
+    EXPECT_EQ(lazy.getPosition(), 750);
+    EXPECT_EQ(lazy.getWindowStart(), 700);
+    EXPECT_EQ(lazy.getLong("weight"), 750);
+    EXPECT_EQ(lazy.getCount(), 1000);
+    EXPECT_EQ(lazy.getColumnsNames().size(), 2u);
+
+    db.close();
+}
+
 // Helper function for multi_threaded_insert_test
 void call_from_thread(sqlite::SQLiteDatabase& db, std::string table) {
     db.insert(table, std::vector<std::string>{"mpg", "weight"}, std::vector<std::string>{"34", "2000"}, "", std::vector<std::string>{});
@@ -276,4 +642,1023 @@ TEST_F(SQLiteDatabaseTestFixture, multi_threaded_insert_test) {
     catch (const std::exception & e){
         std::cout << e.what() << std::endl;
     }
-}
\ No newline at end of file
+}
+TEST_F(SQLiteDatabaseTestFixture, open_options_test) {
+
+    sqlite::OpenOptions options;
+    options.pageSize = 8192;
+    options.journalMode = "WAL";
+    options.synchronous = "NORMAL";
+    options.cacheSize = -4096;
+    options.tempStore = "MEMORY";
+    options.busyTimeout = 250;
+
+    sqlite::SQLiteDatabase db;
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, options);
+
+    auto c = db.query("PRAGMA page_size");
+    c.next();
+    EXPECT_EQ(c.getInt(1), 8192);
+
+    c = db.query("PRAGMA journal_mode");
+    c.next();
+    EXPECT_STREQ(c.getString(1).c_str(), "wal");
+
+    c = db.query("PRAGMA synchronous");
+    c.next();
+    EXPECT_EQ(c.getInt(1), 1);
+
+    c = db.query("PRAGMA cache_size");
+    c.next();
+    EXPECT_EQ(c.getInt(1), -4096);
+
+    c = db.query("PRAGMA temp_store");
+    c.next();
+    EXPECT_EQ(c.getInt(1), 2);
+
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (mpg integer, weight integer)");
+    db.execQuery("PRAGMA journal_mode = DELETE");
+    db.close();
+
+    // immutable connections are read only and skip locking
+    sqlite::OpenOptions immutable;
+    immutable.immutable = true;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE, immutable);
+    EXPECT_NO_THROW(db.query("SELECT * FROM cars"));
+    EXPECT_THROW(db.execQuery("INSERT INTO cars VALUES(1, 1)"), sqlite::SQLiteDatabaseException);
+    db.close();
+
+    // URI characters in plain paths are escaped, not parsed as query or fragment
+    const std::string oddName = "odd?name#%41.db";
+    remove(oddName.c_str());
+    db.open(oddName, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    db.execQuery("CREATE TABLE odd (id integer)");
+    db.close();
+
+    db.open(oddName, SQLITE_OPEN_READWRITE, immutable);
+    EXPECT_NO_THROW(db.query("SELECT * FROM odd"));
+    db.close();
+    EXPECT_FALSE(std::ifstream("odd").good());
+    EXPECT_FALSE(std::ifstream("oddA.db").good());
+    remove(oddName.c_str());
+
+    // bad pragma values fail the open and leave the connection closed
+    sqlite::OpenOptions bad;
+    bad.synchronous = "NORMAL FULL";
+    EXPECT_THROW(db.open(test_database_filename_, SQLITE_OPEN_READWRITE, bad), sqlite::SQLiteDatabaseException);
+    EXPECT_FALSE(db.isOpen());
+}
+
+TEST_F(SQLiteDatabaseTestFixture, async_database_test) {
+
+    sqlite::SQLiteDatabase db;
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+    {
+        sqlite::SQLiteAsyncDatabase async(db);
+
+        // operations run in submission order
+        auto created = async.execAsync("CREATE TABLE IF NOT EXISTS cars (mpg integer, weight integer)");
+        auto id = async.insertAsync("cars", std::vector<std::string>{"mpg", "weight"},
+                                    std::vector<sqlite::Value>{34, 2000});
+        auto id2 = async.insertAsync("cars", std::vector<std::string>{"mpg", "weight"},
+                                     std::vector<sqlite::Value>{27, 25000});
+        auto cars = async.queryAsync("SELECT mpg FROM cars ORDER BY mpg");
+        auto version = async.submit([](sqlite::SQLiteDatabase& db) { return db.getVersion(); });
+
+        EXPECT_NO_THROW(created.get());
+        EXPECT_EQ(id.get(), 1);
+        EXPECT_EQ(id2.get(), 2);
+
+        auto c = cars.get();
+        EXPECT_EQ(c.getCount(), 2);
+        c.next();
+        EXPECT_EQ(c.getInt(1), 27);
+
+        EXPECT_EQ(version.get(), 0);
+
+        // errors are delivered through the future
+        auto bad = async.queryAsync("SELECT * FROM trucks");
+        EXPECT_THROW(bad.get(), sqlite::SQLiteDatabaseException);
+
+        async.shutdown();
+        EXPECT_THROW(async.execAsync("DELETE FROM cars"), sqlite::SQLiteDatabaseException);
+    }
+
+    db.close();
+}
+
+TEST_F(SQLiteDatabaseTestFixture, write_queue_test) {
+
+    sqlite::SQLiteDatabase db;
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (mpg integer, weight integer)");
+
+    {
+        sqlite::SQLiteWriteQueue queue(db, 50, std::chrono::milliseconds(5));
+
+        // many writers, one transaction per batch
+        std::vector<std::thread> threads;
+        for (auto ii = 0; ii < 4; ii++) {
+            threads.push_back(std::thread([&queue, ii]() {
+                std::vector<std::future<long long>> ids;
+                for (auto jj = 0; jj < 50; jj++) {
+                    ids.push_back(queue.insert("cars", std::vector<std::string>{"mpg", "weight"},
+                                               std::vector<sqlite::Value>{ii, jj}));
+                }
+                for (auto& id : ids) {
+                    EXPECT_GT(id.get(), 0);
+                }
+            }));
+        }
+
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        EXPECT_EQ(queue.mutationsCommitted(), 200u);
+        EXPECT_LT(queue.batchesCommitted(), 200u);
+
+        // a failing mutation is rolled back on its own
+        auto good = queue.submit([](sqlite::SQLiteDatabase& db) { db.execQuery("DELETE FROM cars WHERE mpg = 0"); });
+        auto bad = queue.submit([](sqlite::SQLiteDatabase& db) {
+            db.execQuery("DELETE FROM cars");
+            db.execQuery("INSERT INTO trucks VALUES(1)");
+        });
+
+        EXPECT_NO_THROW(good.get());
+        EXPECT_THROW(bad.get(), sqlite::SQLiteDatabaseException);
+    }
+
+    auto c = db.query("SELECT COUNT(*) FROM cars");
+    c.next();
+    EXPECT_EQ(c.getInt(1), 150);
+
+    db.close();
+}
+
+TEST_F(SQLiteDatabaseTestFixture, statement_stats_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (make text, mpg integer, weight integer)");
+
+    EXPECT_EQ(db.getStats(), nullptr);
+
+    db.setStatsEnabled(true);
+    ASSERT_NE(db.getStats(), nullptr);
+
+    const std::string table = "cars";
+    for (auto ii = 0; ii < 10; ii++) {
+        db.insert(table, {"make", "mpg", "weight"}, std::vector<sqlite::Value>{"Ford", ii, 2000 + ii});
+    }
+
+    // literals are normalized so both queries share one entry
+    db.query("SELECT make FROM cars WHERE weight > 2004");
+    db.query("SELECT make FROM cars   WHERE weight > 2008;");
+
+    auto entries = db.getStats()->snapshot();
+
+    auto find = [&entries](const std::string& sql) -> const sqlite::StatementStats::Entry* {
+        for (auto& e : entries) {
+            if (e.sql == sql) {
+                return &e;
+            }
+        }
+        return nullptr;
+    };
+
+    auto insert = find("INSERT INTO cars(make, mpg, weight) VALUES (?, ?, ?)");
+    ASSERT_NE(insert, nullptr);
+    EXPECT_EQ(insert->executions, 10u);
+    EXPECT_EQ(insert->rowsChanged, 10u);
+    EXPECT_EQ(insert->cacheMisses, 1u);
+    EXPECT_EQ(insert->cacheHits, 9u);
+    EXPECT_EQ(insert->prepareTime.count, 10u);
+    EXPECT_EQ(insert->stepTime.count, 10u);
+
+    auto select = find("SELECT make FROM cars WHERE weight > ?");
+    ASSERT_NE(select, nullptr);
+    EXPECT_EQ(select->executions, 2u);
+    EXPECT_EQ(select->rowsReturned, 6u);
+    EXPECT_EQ(select->rowsChanged, 0u);
+    EXPECT_EQ(select->bytesMaterialized, 6u * 5u);
+    EXPECT_GE(select->stepTime.percentile(0.99), select->stepTime.percentile(0.5));
+
+    // sql with inlined literals past the raw sql memo still lands in one entry
+    db.getStats()->reset();
+    for (auto ii = 0; ii < 1500; ii++) {
+        db.execQuery("UPDATE cars SET mpg = " + std::to_string(ii) + " WHERE weight = 2000");
+    }
+    entries = db.getStats()->snapshot();
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].sql, "UPDATE cars SET mpg = ? WHERE weight = ?");
+    EXPECT_EQ(entries[0].executions, 1500u);
+
+    db.getStats()->reset();
+    EXPECT_TRUE(db.getStats()->snapshot().empty());
+
+    db.setStatsEnabled(false);
+    EXPECT_EQ(db.getStats(), nullptr);
+    db.query("SELECT make FROM cars");
+
+    db.close();
+}
+
+TEST_F(SQLiteDatabaseTestFixture, blob_stream_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    db.execQuery("CREATE TABLE IF NOT EXISTS files (name text, data blob)");
+
+    // reserve an odd sized blob and fill it a chunk at a time
+    const std::size_t size = 1024 * 1024 + 3;
+    db.rawQuery("INSERT INTO files (name, data) VALUES (?, zeroblob(?))",
+                std::vector<sqlite::Value>{"big", static_cast<long long>(size)});
+    auto c = db.rawQuery("SELECT rowid FROM files WHERE name = ?", std::vector<sqlite::Value>{"big"});
+    ASSERT_TRUE(c.next());
+    auto bigRowid = c.getLong(1);
+
+    {
+        auto blob = db.openBlob("files", "data", bigRowid, true);
+        EXPECT_EQ(blob.size(), size);
+
+        std::vector<char> chunk(60000);
+        std::size_t written = 0;
+        while (written < size) {
+            auto count = std::min(chunk.size(), size - written);
+            for (auto ii = 0; ii < count; ii++) {
+                chunk[ii] = static_cast<char>((written + ii) % 251);
+            }
+            blob.write(chunk.data(), count);
+            written += count;
+        }
+
+        EXPECT_EQ(blob.tell(), size);
+        EXPECT_THROW(blob.write(chunk.data(), 1), sqlite::SQLiteDatabaseException);
+        blob.close();
+    }
+
+    auto blob = db.openBlob("files", "data", bigRowid);
+    std::size_t read = 0;
+    bool matches = true;
+    blob.readChunks([&](const char* data, std::size_t count) {
+        for (auto ii = 0; ii < count; ii++) {
+            matches = matches && data[ii] == static_cast<char>((read + ii) % 251);
+        }
+        read += count;
+    });
+    EXPECT_EQ(read, size);
+    EXPECT_TRUE(matches);
+
+    char byte;
+    blob.readAt(&byte, 1, 252);
+    EXPECT_EQ(byte, 1);
+    EXPECT_THROW(blob.writeAt(&byte, 1, 0), sqlite::SQLiteDatabaseException);
+
+    // materialized blobs keep embedded NULs and are read without a copy
+    const char small[] = {'a', 0, 'b', 0, 'c'};
+    db.insert("files", {"name", "data"}, std::vector<sqlite::Value>{"small", sqlite::Value::blob(small, sizeof(small))});
+
+    auto smallRowid = db.rawQuery("SELECT rowid FROM files WHERE name = ?", std::vector<sqlite::Value>{"small"});
+    ASSERT_TRUE(smallRowid.next());
+    blob.reopen(smallRowid.getLong(1));
+    EXPECT_EQ(blob.size(), sizeof(small));
+    EXPECT_EQ(blob.tell(), 0u);
+    blob.close();
+
+    auto cursor = db.rawQuery("SELECT data FROM files WHERE name = ?", std::vector<sqlite::Value>{"small"});
+    ASSERT_TRUE(cursor.next());
+    auto view = cursor.getBlob("data");
+    EXPECT_EQ(view.size(), sizeof(small));
+    EXPECT_EQ(view, std::string(small, sizeof(small)));
+
+    db.close();
+}
+
+TEST_F(SQLiteDatabaseTestFixture, export_query_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (make text, mpg integer, weight real, photo blob)");
+
+    const char photo[] = {0, 1, static_cast<char>(0xFF)};
+    db.insert("cars", {"make", "mpg", "weight", "photo"},
+              std::vector<sqlite::Value>{"Ford, \"Model T\"", 27, 2000.5, sqlite::Value::blob(photo, sizeof(photo))});
+    db.insert("cars", {"make", "mpg"}, std::vector<sqlite::Value>{"Tesla\nS", 0});
+
+    const std::string sql = "SELECT make, mpg, weight, photo FROM cars ORDER BY rowid";
+
+    std::ostringstream csv;
+    {
+        sqlite::ResultExporter exporter(csv, sqlite::ResultExporter::Csv);
+        EXPECT_EQ(db.exportQuery(sql, {}, exporter), 2);
+    }
+    EXPECT_EQ(csv.str(), "make,mpg,weight,photo\r\n"
+                         "\"Ford, \"\"Model T\"\"\",27,2000.5,0001ff\r\n"
+                         "\"Tesla\nS\",0,,\r\n");
+
+    // a tiny block size forces the output through the sink in many pieces
+    std::string json;
+    std::size_t blocks = 0;
+    sqlite::ResultExporter jsonExporter([&](const char* data, std::size_t size) {
+        json.append(data, size);
+        blocks++;
+    }, sqlite::ResultExporter::JsonLines, 16);
+
+    db.exportQuery(sql, {}, jsonExporter);
+    EXPECT_GT(blocks, 1u);
+    EXPECT_EQ(json, "{\"make\":\"Ford, \\\"Model T\\\"\",\"mpg\":27,\"weight\":2000.5,\"photo\":\"0001ff\"}\n"
+                    "{\"make\":\"Tesla\\nS\",\"mpg\":0,\"weight\":null,\"photo\":null}\n");
+    EXPECT_EQ(jsonExporter.getBytesWritten(), json.size());
+
+    std::string binary;
+    sqlite::ResultExporter binaryExporter([&](const char* data, std::size_t size) { binary.append(data, size); },
+                                          sqlite::ResultExporter::Binary);
+    db.exportQuery("SELECT mpg, make FROM cars WHERE mpg = ?", std::vector<sqlite::Value>{27}, binaryExporter);
+
+    // magic, 2 columns, "mpg", "make", then an INTEGER cell and a TEXT cell
+    const std::string expected = std::string("CQLB\x02\0\0\0\x03\0\0\0mpg\x04\0\0\0make", 23)
+                               + std::string("\x01\x1b\0\0\0\0\0\0\0", 9)
+                               + std::string("\x03\x0f\0\0\0", 5) + "Ford, \"Model T\"";
+    EXPECT_EQ(binary, expected);
+
+    db.close();
+}
+
+TEST_F(SQLiteDatabaseTestFixture, backup_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (make text, mpg integer, weight integer)");
+
+    std::vector<std::vector<sqlite::Value>> rows;
+    for (auto ii = 0; ii < 2000; ii++) {
+        rows.push_back(std::vector<sqlite::Value>{std::string(200, 'a' + ii % 26), ii, 2000 + ii});
+    }
+    db.insertMany("cars", {"make", "mpg", "weight"}, rows);
+
+    // a write from another connection between steps makes the backup start over
+    sqlite::SQLiteDatabase writer;
+    writer.open(test_database_filename_, SQLITE_OPEN_READWRITE);
+
+    sqlite::SQLiteDatabase copy;
+    copy.open("backup_test.db", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+    int calls = 0;
+    sqlite::SQLiteBackup backup(copy, db);
+    EXPECT_TRUE(backup.run(10, 0, [&](int remaining, int pageCount) {
+        EXPECT_LE(remaining, pageCount);
+        if (++calls == 3) {
+            writer.insert("cars", {"make", "mpg", "weight"}, std::vector<sqlite::Value>{"Ford", 27, 2000});
+        }
+        return true;
+    }));
+
+    EXPECT_TRUE(backup.isDone());
+    EXPECT_EQ(backup.getRemaining(), 0);
+    EXPECT_GE(backup.getRestarts(), 1u);
+    EXPECT_GT(calls, 3);
+
+    auto c = copy.query("SELECT COUNT(*) FROM cars");
+    c.next();
+    EXPECT_EQ(c.getInt(1), 2001);
+    copy.close();
+    writer.close();
+
+    // serve from memory, then write the changes back to a file
+    sqlite::SQLiteDatabase memory;
+    memory.open(":memory:", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    memory.setMaxResultCacheSize(sqlite::ResultCache::kDefaultMaxBytes);
+    sqlite::SQLiteBackup::load(memory, "backup_test.db");
+    memory.remove("cars", "mpg < ?", std::vector<sqlite::Value>{1000});
+    sqlite::SQLiteBackup::save(memory, "backup_test.db", 50, 1);
+
+    // a backup into the connection bypasses its hooks but must not leave stale cached results
+    c = memory.query("SELECT COUNT(*) FROM cars");
+    c.next();
+    EXPECT_EQ(c.getInt(1), 1000);
+    sqlite::SQLiteBackup(memory, db).run();
+    c = memory.query("SELECT COUNT(*) FROM cars");
+    c.next();
+    EXPECT_EQ(c.getInt(1), 2001);
+
+    sqlite::SQLiteDatabase saved;
+    saved.open("backup_test.db", SQLITE_OPEN_READONLY);
+    c = saved.query("SELECT COUNT(*) FROM cars");
+    c.next();
+    EXPECT_EQ(c.getInt(1), 1000);
+    saved.close();
+
+    memory.close();
+    db.close();
+    remove("backup_test.db");
+}
+
+TEST_F(SQLiteDatabaseTestFixture, result_cache_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (make text, mpg integer, weight integer)");
+    db.execQuery("CREATE TABLE IF NOT EXISTS owners (name text)");
+    db.execQuery("CREATE VIEW IF NOT EXISTS heavy_cars AS SELECT make FROM cars WHERE weight > 2500");
+    db.insert("owners", {"name"}, std::vector<sqlite::Value>{"Matt"});
+
+    EXPECT_EQ(db.getResultCache(), nullptr);
+    db.setMaxResultCacheSize(sqlite::ResultCache::kDefaultMaxBytes);
+    auto cache = db.getResultCache();
+    ASSERT_NE(cache, nullptr);
+
+    auto countCars = [&db]() {
+        auto c = db.query(false, "cars", {"COUNT(*)"}, "weight > ?", {"1000"}, "", "", "");
+        c.next();
+        return c.getInt(1);
+    };
+
+    // writes are never cached
+    db.rawQuery("INSERT INTO cars (make, mpg, weight) VALUES (?, ?, ?)", {"Ford", 27, 2000});
+    db.rawQuery("INSERT INTO cars (make, mpg, weight) VALUES (?, ?, ?)", {"Tesla", 0, 3000});
+    EXPECT_EQ(cache->size(), 0u);
+
+    EXPECT_EQ(countCars(), 2);
+    EXPECT_EQ(countCars(), 2);
+    EXPECT_EQ(cache->hits(), 1u);
+
+    db.query("SELECT name FROM owners");
+    db.query("SELECT make FROM heavy_cars");
+    EXPECT_EQ(cache->size(), 3u);
+
+    // only results reading cars, directly or through the view, are dropped
+    db.insert("cars", {"make", "mpg", "weight"}, std::vector<sqlite::Value>{"Toyota", 40, 2600});
+    EXPECT_EQ(cache->size(), 1u);
+    EXPECT_EQ(countCars(), 3);
+    EXPECT_EQ(db.query("SELECT make FROM heavy_cars").getCount(), 2);
+
+    // uncommitted rows are never cached and a rollback keeps the cached results
+    auto hits = cache->hits();
+    db.beginTransaction();
+    db.insert("cars", {"make", "mpg", "weight"}, std::vector<sqlite::Value>{"Fiat", 35, 1800});
+    EXPECT_EQ(countCars(), 4);
+    db.rollback();
+    EXPECT_EQ(countCars(), 3);
+    EXPECT_EQ(cache->hits(), hits + 1);
+
+    // cached cursors are shared but every copy has its own position
+    auto first = db.query("SELECT name FROM owners");
+    auto second = db.query("SELECT name FROM owners");
+    EXPECT_TRUE(first.next());
+    EXPECT_EQ(second.getPosition(), -1);
+
+    // DELETE without WHERE is still seen
+    db.execQuery("DELETE FROM owners");
+    EXPECT_EQ(cache->size(), 2u);
+    EXPECT_EQ(db.query("SELECT name FROM owners").getCount(), 0);
+
+    // the budget evicts the least recently used results
+    db.setMaxResultCacheSize(1);
+    countCars();
+    EXPECT_EQ(cache->size(), 0u);
+    EXPECT_EQ(cache->bytes(), 0u);
+
+    // dropping a table drops everything
+    db.setMaxResultCacheSize(sqlite::ResultCache::kDefaultMaxBytes);
+    countCars();
+    EXPECT_EQ(cache->size(), 1u);
+    db.execQuery("DROP VIEW heavy_cars");
+    EXPECT_EQ(cache->size(), 0u);
+
+    // results that don't only come from table rows are never cached
+    auto scalar = [&db](const std::string& sql) {
+        auto c = db.query(sql);
+        c.next();
+        return c.getString(1);
+    };
+    cache->clear();
+    db.insert("owners", {"name"}, std::vector<sqlite::Value>{"Ann"});
+    auto rowid = scalar("SELECT last_insert_rowid()");
+    db.insert("owners", {"name"}, std::vector<sqlite::Value>{"Bob"});
+    EXPECT_NE(scalar("SELECT last_insert_rowid()"), rowid);
+
+    EXPECT_EQ(scalar("PRAGMA user_version"), "0");
+    db.execQuery("PRAGMA user_version = 7");
+    EXPECT_EQ(scalar("PRAGMA user_version"), "7");
+    db.execQuery("PRAGMA user_version = 0");
+
+    EXPECT_NE(scalar("SELECT random() FROM owners LIMIT 1"), scalar("SELECT random() FROM owners LIMIT 1"));
+    scalar("SELECT COUNT(*), date('now') FROM owners");
+    scalar("SELECT COUNT(*), CURRENT_TIMESTAMP FROM owners");
+    scalar("SELECT name FROM pragma_table_info('owners')");
+    EXPECT_EQ(cache->size(), 0u);
+
+    // date functions of stored values are deterministic
+    scalar("SELECT date('2026-10-18') FROM owners");
+    EXPECT_EQ(cache->size(), 1u);
+
+    db.setMaxResultCacheSize(0);
+    EXPECT_EQ(db.getResultCache(), nullptr);
+    EXPECT_EQ(countCars(), 3);
+
+    db.close();
+}
+
+TEST_F(SQLiteDatabaseTestFixture, observe_query_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (make text, mpg integer, weight integer)");
+    db.execQuery("CREATE TABLE IF NOT EXISTS owners (name text)");
+    db.insert("cars", {"make", "mpg", "weight"}, std::vector<sqlite::Value>{"Ford", 27, 2000});
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<sqlite::QueryChange> changes;
+
+    auto waitForChanges = [&](const std::size_t count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return changed.wait_for(lock, std::chrono::seconds(5), [&] { return changes.size() >= count; });
+    };
+
+    auto observer = db.getQueryObserver();
+    observer->setCoalesceDelay(50);
+
+    auto subscription = db.observe("SELECT make FROM cars WHERE weight > ? ORDER BY make", {1000},
+                                   [&](const sqlite::QueryChange& change) {
+        std::lock_guard<std::mutex> lock(mutex);
+        changes.push_back(change);
+        changed.notify_all();
+    });
+
+    // the first result is delivered before observe returns
+    ASSERT_EQ(changes.size(), 1u);
+    EXPECT_EQ(changes[0].result.getCount(), 1);
+    EXPECT_EQ(changes[0].added, std::vector<int>{0});
+    EXPECT_TRUE(subscription.isActive());
+
+    // writes committed together are delivered as one change, one commit doesn't depend on the coalesce delay
+    {
+        sqlite::Transaction transaction(db);
+        db.insert("cars", {"make", "mpg", "weight"}, std::vector<sqlite::Value>{"Tesla", 0, 3000});
+        db.insert("cars", {"make", "mpg", "weight"}, std::vector<sqlite::Value>{"Audi", 30, 2500});
+        transaction.commit();
+    }
+    ASSERT_TRUE(waitForChanges(2));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto change = changes[1];
+        EXPECT_EQ(change.result.getCount(), 3);
+        EXPECT_EQ(change.added, (std::vector<int>{0, 2}));
+        EXPECT_TRUE(change.removed.empty());
+        EXPECT_EQ(observer->reruns(), 1u);
+    }
+
+    // other tables, rolled back writes and writes that leave the result alone don't call back
+    db.insert("owners", {"name"}, std::vector<sqlite::Value>{"Matt"});
+    db.beginTransaction();
+    db.execQuery("DELETE FROM cars");
+    db.rollback();
+    db.insert("cars", {"make", "mpg", "weight"}, std::vector<sqlite::Value>{"Fiat", 35, 800});
+
+    // an update shows up as a removed and an added row
+    db.update("cars", {"make"}, std::vector<sqlite::Value>{"Volvo"}, "make = ?", std::vector<sqlite::Value>{"Ford"});
+    ASSERT_TRUE(waitForChanges(3));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto change = changes[2];
+        ASSERT_EQ(change.removed, std::vector<int>{1});
+        ASSERT_EQ(change.added, std::vector<int>{2});
+        change.previous.moveToPosition(1);
+        EXPECT_EQ(change.previous.getString(1), "Ford");
+        change.result.moveToPosition(2);
+        EXPECT_EQ(change.result.getString(1), "Volvo");
+    }
+
+    // no callbacks once the subscription is cancelled
+    subscription.cancel();
+    EXPECT_FALSE(subscription.isActive());
+    EXPECT_EQ(observer->size(), 0u);
+    db.execQuery("DELETE FROM cars");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(changes.size(), 3u);
+
+    // observed inside a transaction, the first result waits for it to end and never holds its rows
+    db.beginTransaction();
+    db.insert("cars", {"make", "mpg", "weight"}, std::vector<sqlite::Value>{"Kia", 30, 1500});
+    subscription = db.observe("SELECT make FROM cars", {}, [&](const sqlite::QueryChange& change) {
+        std::lock_guard<std::mutex> lock(mutex);
+        changes.push_back(change);
+        changed.notify_all();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(changes.size(), 3u);
+    db.rollback();
+    ASSERT_TRUE(waitForChanges(4));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQ(changes[3].result.getCount(), 0);
+        EXPECT_TRUE(changes[3].added.empty());
+    }
+    subscription.cancel();
+
+    EXPECT_THROW(db.observe("SELECT * FROM trucks", {}, [](const sqlite::QueryChange&) {}),
+                 sqlite::SQLiteDatabaseException);
+
+    db.close();
+}
+
+TEST_F(SQLiteDatabaseTestFixture, busy_policy_test) {
+
+    sqlite::SQLiteDatabase holder;
+    sqlite::SQLiteDatabase db;
+
+    holder.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    holder.execQuery("CREATE TABLE IF NOT EXISTS cars (make text, mpg integer, weight integer)");
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+    std::vector<std::string> columns{"make", "mpg", "weight"};
+    std::vector<sqlite::Value> car{"Ford", 27, 2000};
+
+    // the default policy fails right away and counts nothing
+    holder.beginTransaction(sqlite::SQLiteDatabase::Exclusive);
+    EXPECT_THROW(db.insert("cars", columns, car), sqlite::SQLiteDatabaseException);
+    EXPECT_EQ(db.getLockWaitStats().waits, 0u);
+
+    // backoff gives up once the wait budget is spent
+    db.setBusyPolicy(sqlite::BusyPolicy::backoff(50));
+    EXPECT_THROW(db.insert("cars", columns, car), sqlite::SQLiteDatabaseException);
+    auto stats = db.getLockWaitStats();
+    EXPECT_EQ(stats.waits, 1u);
+    EXPECT_EQ(stats.timeouts, 1u);
+    EXPECT_GT(stats.retries, 1u);
+    EXPECT_GE(stats.waitTime, 40 * 1000 * 1000LL);
+    EXPECT_EQ(stats.maxWaitTime, stats.waitTime);
+
+    // custom handlers get the retry count
+    std::vector<int> counts;
+    db.setBusyPolicy(sqlite::BusyPolicy::custom([&counts](int count) {
+        counts.push_back(count);
+        return count < 2;
+    }));
+    EXPECT_THROW(db.beginTransaction(sqlite::SQLiteDatabase::Immediate), sqlite::SQLiteDatabaseException);
+    EXPECT_EQ(counts, (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(db.getLockWaitStats().retries, 2u);
+
+    // the wait ends as soon as the lock is released
+    db.setBusyPolicy(sqlite::BusyPolicy::timeout(5000));
+    std::thread release([&holder]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        holder.rollback();
+    });
+    EXPECT_NO_THROW(db.beginTransaction(sqlite::SQLiteDatabase::Immediate));
+    release.join();
+    EXPECT_NO_THROW(db.insert("cars", columns, car));
+    db.endTransaction();
+
+    stats = db.getLockWaitStats();
+    EXPECT_EQ(stats.waits, 1u);
+    EXPECT_EQ(stats.timeouts, 0u);
+    EXPECT_LT(stats.waitTime, 5000 * 1000 * 1000LL);
+
+    db.resetLockWaitStats();
+    EXPECT_EQ(db.getLockWaitStats().waits, 0u);
+
+    db.close();
+    holder.close();
+}
+
+TEST_F(SQLiteDatabaseTestFixture, transaction_guard_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (make text, mpg integer, weight integer)");
+
+    std::vector<std::string> columns{"make", "mpg", "weight"};
+
+    auto countCars = [&db]() {
+        auto c = db.query("SELECT COUNT(*) FROM cars");
+        c.next();
+        return c.getInt(1);
+    };
+
+    // an exception unwinding the guard rolls back
+    EXPECT_THROW({
+        sqlite::Transaction transaction(db, sqlite::SQLiteDatabase::Immediate);
+        EXPECT_TRUE(db.inTransaction());
+        EXPECT_FALSE(transaction.isNested());
+        db.insert("cars", columns, std::vector<sqlite::Value>{"Ford", 27, 2000});
+        db.execQuery("INSERT INTO trucks VALUES(1)");
+    }, sqlite::SQLiteDatabaseException);
+    EXPECT_FALSE(db.inTransaction());
+    EXPECT_EQ(countCars(), 0);
+
+    {
+        sqlite::Transaction outer(db);
+        db.insert("cars", columns, std::vector<sqlite::Value>{"Ford", 27, 2000});
+
+        // nested guards are savepoints, rolling one back keeps the outer writes
+        {
+            sqlite::Transaction inner(db);
+            EXPECT_TRUE(inner.isNested());
+            db.insert("cars", columns, std::vector<sqlite::Value>{"Tesla", 0, 3000});
+        }
+        EXPECT_TRUE(db.inTransaction());
+        EXPECT_EQ(countCars(), 1);
+
+        {
+            sqlite::Transaction inner(db);
+            db.insert("cars", columns, std::vector<sqlite::Value>{"Audi", 30, 2500});
+            {
+                sqlite::Transaction innermost(db);
+                db.insert("cars", columns, std::vector<sqlite::Value>{"Fiat", 35, 1800});
+                innermost.rollback();
+                EXPECT_FALSE(innermost.isActive());
+            }
+            inner.commit();
+        }
+        EXPECT_EQ(countCars(), 2);
+
+        outer.commit();
+        EXPECT_THROW(outer.commit(), sqlite::SQLiteDatabaseException);
+    }
+    EXPECT_FALSE(db.inTransaction());
+    EXPECT_EQ(countCars(), 2);
+
+    // a guard whose transaction was already ended by hand doesn't throw
+    {
+        sqlite::Transaction transaction(db);
+        db.rollback();
+    }
+
+    // the plain calls reuse the prepared statements
+    db.beginTransaction(sqlite::SQLiteDatabase::Exclusive);
+    db.execQuery("DELETE FROM cars");
+    db.rollback();
+    db.beginTransaction();
+    EXPECT_THROW(db.beginTransaction(), sqlite::SQLiteDatabaseException);
+    db.endTransaction();
+    EXPECT_EQ(countCars(), 2);
+
+    db.close();
+}
+
+TEST_F(SQLiteDatabaseTestFixture, bound_statement_test) {
+
+    EXPECT_EQ(sqlite::SqlBuilder::select(true, "cars", {"make", "mpg"}, "weight > ?", "make", "mpg DESC", "10"),
+              "SELECT DISTINCT make, mpg FROM cars WHERE weight > ? GROUP BY make ORDER BY mpg DESC LIMIT 10");
+    EXPECT_EQ(sqlite::SqlBuilder::select(false, "cars", {}, "", "", "", ""), "SELECT * FROM cars");
+    EXPECT_EQ(sqlite::SqlBuilder::update("cars", {"mpg", "weight"}, "make = ?"),
+              "UPDATE cars SET mpg = ?, weight = ? WHERE make = ?");
+    EXPECT_EQ(sqlite::SqlBuilder::remove("cars", "make = ?"), "DELETE FROM cars WHERE make = ?");
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (make text, mpg integer, weight integer)");
+
+    {
+        auto insertCar = db.prepareInsert("cars", {"make", "mpg", "weight"});
+        EXPECT_EQ(insertCar.getSql(), "INSERT INTO cars(make, mpg, weight) VALUES (?, ?, ?)");
+        EXPECT_EQ(insertCar.getParameterCount(), 3);
+
+        // every supported argument type binds in place
+        std::string make = "Tesla";
+        EXPECT_EQ(insertCar.insert("Ford", 27, 2000), 1);
+        EXPECT_EQ(insertCar.insert(make, 0LL, 3000.5), 2);
+        EXPECT_EQ(insertCar.insert(sqlite::Value("Audi"), nullptr, 2500L), 3);
+
+        // argument count is checked
+        EXPECT_THROW(insertCar.insert("Fiat", 35), sqlite::SQLiteDatabaseException);
+
+        auto updateMpg = db.prepareUpdate("cars", {"mpg"}, "make = ?");
+        EXPECT_EQ(updateMpg.execute(30, "Audi"), 1);
+        EXPECT_EQ(updateMpg.execute(30, "Fiat"), 0);
+
+        auto heavyCars = db.prepareQuery(false, "cars", {"make", "mpg"}, "weight > ?", "", "weight");
+        auto c = heavyCars.query(2200);
+        EXPECT_EQ(c.getCount(), 2);
+        c.next();
+        EXPECT_EQ(c.getString(1), "Audi");
+        EXPECT_EQ(c.getInt(2), 30);
+
+        // the same statement runs again with new arguments
+        EXPECT_EQ(heavyCars.query(1000).getCount(), 3);
+
+        auto removeCar = db.prepareRemove("cars", "make = ?");
+        EXPECT_EQ(removeCar.execute(make), 1);
+
+        sqlite::BoundStatement moved = std::move(removeCar);
+        EXPECT_FALSE(removeCar.isValid());
+        EXPECT_EQ(moved.execute("Ford"), 1);
+
+        EXPECT_THROW(db.prepare("SELECT * FROM trucks"), sqlite::SQLiteDatabaseException);
+
+        // a bare ByteView binds as text, a BlobView as a blob
+        const char bytes[] = {'a', '\0', 'b'};
+        auto type = db.prepare("SELECT typeof(?), length(CAST(? AS BLOB))");
+        c = type.query(sqlite::ByteView(bytes, 3), sqlite::ByteView(bytes, 3));
+        c.next();
+        EXPECT_EQ(c.getString(1), "text");
+        c = type.query(sqlite::BlobView(bytes, 3), sqlite::BlobView(sqlite::ByteView(bytes, 3)));
+        c.next();
+        EXPECT_EQ(c.getString(1), "blob");
+        EXPECT_EQ(c.getInt(2), 3);
+    }
+
+    db.close();
+}
+
+namespace {
+
+struct Product {
+    double value = 1;
+    void step(double x) { value *= x; }
+    double result() const { return value; }
+};
+
+struct MovingSum {
+    long long sum = 0;
+    void step(long long x) { sum += x; }
+    void inverse(long long x) { sum -= x; }
+    long long result() const { return sum; }
+};
+
+} /* namespace */
+
+TEST_F(SQLiteDatabaseTestFixture, create_function_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    db.execQuery("CREATE TABLE IF NOT EXISTS cars (make text, mpg integer, weight integer)");
+    db.insertMany("cars", {"make", "mpg", "weight"}, std::vector<std::vector<sqlite::Value>>{
+            {"Ford", 27, 2000}, {"Tesla", 0, 3000}, {"Audi", 30, 2500}});
+
+    // scalar functions from lambdas, argument and result types come from the signature
+    auto calls = 0;
+    db.createFunction("kpl", [&calls](double mpg) {
+        calls++;
+        return mpg * 0.425;
+    }, sqlite::Deterministic | sqlite::Innocuous);
+    db.createFunction("label", [](const std::string& make, int mpg) { return make + ":" + std::to_string(mpg); },
+                      sqlite::Deterministic);
+    db.createFunction("is_null", [](const sqlite::Value& value) { return value.isNull(); });
+    db.createFunction("fail", [](int) -> int { throw std::runtime_error("no trucks"); });
+
+    auto c = db.query("SELECT kpl(mpg), label(make, mpg), is_null(NULL), is_null(0) FROM cars WHERE make = 'Audi'");
+    ASSERT_TRUE(c.next());
+    EXPECT_DOUBLE_EQ(c.getDouble(1), 12.75);
+    EXPECT_EQ(c.getString(2), "Audi:30");
+    EXPECT_EQ(c.getInt(3), 1);
+    EXPECT_EQ(c.getInt(4), 0);
+
+    // filtering runs inside the engine
+    EXPECT_EQ(db.query("SELECT make FROM cars WHERE kpl(mpg) > 12").getCount(), 1);
+
+    // only deterministic functions can be indexed
+    EXPECT_NO_THROW(db.execQuery("CREATE INDEX cars_kpl ON cars(kpl(mpg))"));
+    db.createFunction("kpl_random", [](double mpg) { return mpg * 0.425; });
+    EXPECT_THROW(db.execQuery("CREATE INDEX cars_kpl_random ON cars(kpl_random(mpg))"),
+                 sqlite::SQLiteDatabaseException);
+
+    // exceptions fail the statement with their message
+    try {
+        db.query("SELECT fail(mpg) FROM cars");
+        FAIL();
+    }
+    catch (const sqlite::SQLiteDatabaseException& e) {
+        EXPECT_NE(std::string(e.what()).find("no trucks"), std::string::npos);
+    }
+
+    // aggregates get one instance per group
+    db.createAggregate<Product>("product", sqlite::Deterministic);
+    c = db.query("SELECT product(mpg), product(weight / 1000.0) FROM cars WHERE mpg > 0");
+    ASSERT_TRUE(c.next());
+    EXPECT_DOUBLE_EQ(c.getDouble(1), 810);
+    EXPECT_DOUBLE_EQ(c.getDouble(2), 5);
+    c = db.query("SELECT product(mpg) FROM cars WHERE mpg > 100");
+    ASSERT_TRUE(c.next());
+    EXPECT_DOUBLE_EQ(c.getDouble(1), 1);
+
+    // window functions remove rows leaving the frame with inverse
+    db.createWindowFunction<MovingSum>("moving_sum", sqlite::Deterministic);
+    c = db.query("SELECT moving_sum(weight) OVER (ORDER BY weight ROWS BETWEEN 1 PRECEDING AND CURRENT ROW) "
+                 "FROM cars ORDER BY weight");
+    std::vector<int> sums;
+    while (c.next()) {
+        sums.push_back(c.getInt(1));
+    }
+    EXPECT_EQ(sums, (std::vector<int>{2000, 4500, 5500}));
+
+    // with the result cache on, functions without Deterministic always run and replacing a function drops results
+    db.setMaxResultCacheSize(sqlite::ResultCache::kDefaultMaxBytes);
+    auto ticks = 0;
+    db.createFunction("tick", [&ticks]() { return ++ticks; });
+    auto scalar = [&db](const std::string& sql) {
+        auto c = db.query(sql);
+        c.next();
+        return c.getInt(1);
+    };
+    EXPECT_EQ(scalar("SELECT tick() FROM cars LIMIT 1"), 1);
+    EXPECT_EQ(scalar("SELECT tick() FROM cars LIMIT 1"), 2);
+
+    db.createFunction("scale", [](int x) { return x * 2; }, sqlite::Deterministic);
+    EXPECT_EQ(scalar("SELECT scale(weight) FROM cars WHERE make = 'Ford'"), 4000);
+    EXPECT_EQ(db.getResultCache()->size(), 1u);
+    db.createFunction("scale", [](int x) { return x * 3; }, sqlite::Deterministic);
+    EXPECT_EQ(scalar("SELECT scale(weight) FROM cars WHERE make = 'Ford'"), 6000);
+
+    db.close();
+    EXPECT_THROW(db.createFunction("kpl", [](double mpg) { return mpg; }), sqlite::SQLiteDatabaseException);
+}
+
+TEST_F(SQLiteDatabaseTestFixture, virtual_table_test) {
+
+    sqlite::SQLiteDatabase db;
+
+    db.open(test_database_filename_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    db.execQuery("CREATE TABLE IF NOT EXISTS owners (name text, make text)");
+    db.insertMany("owners", {"name", "make"}, std::vector<std::vector<sqlite::Value>>{
+            {"Ann", "Audi"}, {"Bob", "Ford"}, {"Cy", "Tesla"}, {"Di", "Audi"}});
+
+    // rows stay in the vector, sorted by make
+    std::vector<Car> cars = {{"Audi", 30, 2500}, {"BMW", 25, 3200}, {"Ford", 27, 2000}, {"Kia", 35, 1800},
+                             {"Tesla", 0, 3000}};
+    sqlite::VirtualTable<std::vector<Car>> table(cars);
+    table.column("make", [](const Car& car) { return car.make; })
+         .column("mpg", [](const Car& car) { return car.mpg; })
+         .column("weight", [](const Car& car) { return car.weight; });
+    table.sortedBy("make");
+    EXPECT_EQ(table.getSchema(), "CREATE TABLE x(\"make\" TEXT, \"mpg\" INTEGER, \"weight\" REAL)");
+    EXPECT_THROW(table.sortedBy("model"), sqlite::SQLiteDatabaseException);
+
+    db.createVirtualTable("mem_cars", table);
+
+    auto c = db.query("SELECT make, mpg, weight FROM mem_cars");
+    EXPECT_EQ(c.getCount(), 5);
+    ASSERT_TRUE(c.next());
+    EXPECT_EQ(c.getString(1), "Audi");
+    EXPECT_EQ(c.getInt(2), 30);
+    EXPECT_DOUBLE_EQ(c.getDouble(3), 2500);
+    EXPECT_EQ(table.getRowsScanned(), 5u);
+
+    // equality on the sorted column binary searches
+    c = db.query("SELECT mpg FROM mem_cars WHERE make = 'Ford'");
+    ASSERT_TRUE(c.next());
+    EXPECT_EQ(c.getInt(1), 27);
+    EXPECT_EQ(table.getRowsScanned(), 1u);
+
+    c = db.query("SELECT make FROM mem_cars WHERE make >= 'BMW' AND make < 'Kia'");
+    EXPECT_EQ(c.getCount(), 2);
+    EXPECT_EQ(table.getRowsScanned(), 2u);
+
+    // rowid is the position in the vector
+    c = db.query("SELECT make FROM mem_cars WHERE rowid = 3");
+    ASSERT_TRUE(c.next());
+    EXPECT_EQ(c.getString(1), "Kia");
+    EXPECT_EQ(table.getRowsScanned(), 1u);
+
+    // other columns are filtered before SQLite reads the row, type mismatches are left to SQLite
+    EXPECT_EQ(db.query("SELECT make FROM mem_cars WHERE mpg > 26 AND weight <= 2500").getCount(), 3);
+    EXPECT_EQ(db.query("SELECT make FROM mem_cars WHERE mpg > '26'").getCount(), 3);
+    EXPECT_EQ(db.query("SELECT make FROM mem_cars WHERE make = 'audi' COLLATE NOCASE").getCount(), 1);
+
+    // joins against database tables
+    c = db.query("SELECT owners.name, mem_cars.mpg FROM owners JOIN mem_cars ON mem_cars.make = owners.make "
+                 "WHERE mem_cars.mpg > 0 ORDER BY owners.name");
+    std::vector<std::string> names;
+    while (c.next()) {
+        names.push_back(c.getString(1) + ":" + std::to_string(c.getInt(2)));
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{"Ann:30", "Bob:27", "Di:30"}));
+
+    // changes to the vector are seen by the next query, even with the result cache, the table is read only
+    db.setMaxResultCacheSize(sqlite::ResultCache::kDefaultMaxBytes);
+    EXPECT_EQ(db.query("SELECT make FROM mem_cars ORDER BY make").getCount(), 5);
+    cars.push_back({"Volvo", 22, 3500});
+    EXPECT_EQ(db.query("SELECT make FROM mem_cars ORDER BY make").getCount(), 6);
+    db.query("SELECT owners.name FROM owners JOIN mem_cars ON mem_cars.make = owners.make");
+    EXPECT_EQ(db.getResultCache()->size(), 0u);
+    EXPECT_THROW(db.execQuery("DELETE FROM mem_cars"), sqlite::SQLiteDatabaseException);
+
+    // integers and reals compare exactly past 2^53, the largest rowid doesn't overflow
+    std::vector<long long> ids = {9007199254740992LL, 9007199254740993LL};
+    sqlite::VirtualTable<std::vector<long long>> idTable(ids);
+    idTable.column("id", [](const long long& id) { return id; })
+           .column("value", [](const long long& id) { return id; });
+    idTable.sortedBy("id");
+    db.createVirtualTable("mem_ids", idTable);
+    EXPECT_EQ(db.query("SELECT id FROM mem_ids WHERE id > 9007199254740992.0").getCount(), 1);
+    EXPECT_EQ(db.query("SELECT id FROM mem_ids WHERE value > 9007199254740992.0").getCount(), 1);
+    EXPECT_EQ(db.query("SELECT id FROM mem_ids WHERE rowid <= 9223372036854775807").getCount(), 2);
+    EXPECT_EQ(db.query("SELECT id FROM mem_ids WHERE rowid > 9223372036854775807").getCount(), 0);
+
+    db.close();
+    EXPECT_THROW(db.createVirtualTable("mem_cars", table), sqlite::SQLiteDatabaseException);
+}
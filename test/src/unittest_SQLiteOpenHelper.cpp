@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include "SQLiteDatabaseHelper.h"
 
+#include <thread>
+#include <vector>
+#include <cstdio>
+
 TEST(SQLiteDatabaseHelper, read_write_test) {
 
     SQLiteDatabaseHelper dbHelper;
@@ -41,3 +45,200 @@ TEST(SQLiteDatabaseHelper, read_only_test) {
     EXPECT_FALSE(db.isOpen());
 }
 
+
+
+// Helper with its own database file so the WAL mode set by the pool does not leak into the other tests
+class PooledCarsHelper : public sqlite::SQLiteOpenHelper {
+public:
+    PooledCarsHelper() : sqlite::SQLiteOpenHelper("pooled_cars", 1) {}
+
+    virtual void onCreate(sqlite::SQLiteDatabase& db) {
+        db.execQuery("CREATE TABLE IF NOT EXISTS cars (mpg integer, weight integer)");
+    }
+
+    virtual void onUpgrade(sqlite::SQLiteDatabase& db) {
+        db.execQuery("DROP TABLE IF EXISTS cars");
+    }
+};
+
+TEST(SQLiteDatabaseHelper, connection_pool_test) {
+
+    remove("pooled_cars.db");
+
+    {
+        PooledCarsHelper dbHelper;
+        dbHelper.setMaxReadConnections(2);
+
+        {
+            auto writer = dbHelper.acquireWriteableDatabase();
+            EXPECT_TRUE(writer.isWriter());
+
+            auto c = writer->query("PRAGMA journal_mode");
+            c.next();
+            EXPECT_STREQ(c.getString(1).c_str(), "wal");
+        }
+
+        // writers serialize on the single writer connection, readers run on their own connections
+        std::vector<std::thread> threads;
+        for (auto ii = 0; ii < 4; ii++) {
+            threads.push_back(std::thread([&dbHelper, ii]() {
+                for (auto jj = 0; jj < 25; jj++) {
+                    auto writer = dbHelper.acquireWriteableDatabase();
+                    writer->insert("cars", std::vector<std::string>{"mpg", "weight"},
+                                   std::vector<sqlite::Value>{ii, jj});
+                }
+            }));
+            threads.push_back(std::thread([&dbHelper]() {
+                for (auto jj = 0; jj < 25; jj++) {
+                    auto reader = dbHelper.acquireReadableDatabase();
+                    EXPECT_FALSE(reader.isWriter());
+                    auto c = reader->query("SELECT COUNT(*) FROM cars");
+                    EXPECT_EQ(c.getCount(), 1);
+                }
+            }));
+        }
+
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        auto reader = dbHelper.acquireReadableDatabase();
+        auto c = reader->query("SELECT COUNT(*) FROM cars");
+        c.next();
+        EXPECT_EQ(c.getInt(1), 100);
+
+        // read connections are read only
+        EXPECT_THROW(reader->execQuery("DELETE FROM cars"), sqlite::SQLiteDatabaseException);
+        reader.release();
+
+        EXPECT_THROW(dbHelper.setMaxReadConnections(4), sqlite::SQLiteDatabaseException);
+
+        dbHelper.close();
+    }
+
+    remove("pooled_cars.db");
+}
+
+// Helper registering its hot statements so they are prepared while the database opens
+class FastStartHelper : public sqlite::SQLiteOpenHelper {
+public:
+    FastStartHelper(const int version, const bool failUpgrade = false)
+            : sqlite::SQLiteOpenHelper("fast_start", version), creates(0), upgrades(0), failUpgrade_(failUpgrade) {
+        registerStatement("insert_car", "INSERT INTO cars (mpg, weight) VALUES (?, ?)");
+        registerStatement("count_cars", "SELECT COUNT(*) FROM cars");
+    }
+
+    virtual void onCreate(sqlite::SQLiteDatabase& db) {
+        creates++;
+        db.execQuery("CREATE TABLE cars (mpg integer, weight integer)");
+    }
+
+    virtual void onUpgrade(sqlite::SQLiteDatabase& db) {
+        upgrades++;
+        db.execQuery("ALTER TABLE cars ADD COLUMN make text");
+        if (failUpgrade_) {
+            throw sqlite::SQLiteDatabaseException("upgrade failed");
+        }
+    }
+
+    int creates;
+    int upgrades;
+
+private:
+    bool failUpgrade_;
+};
+
+TEST(SQLiteDatabaseHelper, fast_start_test) {
+
+    remove("fast_start.db");
+
+    {
+        FastStartHelper dbHelper(1);
+
+        // statements are ready as soon as the database is open
+        dbHelper.getStatement("insert_car").insert(27, 2000);
+        auto c = dbHelper.getStatement("count_cars").query();
+        ASSERT_TRUE(c.next());
+        EXPECT_EQ(c.getInt(1), 1);
+        EXPECT_THROW(dbHelper.getStatement("delete_cars"), sqlite::SQLiteDatabaseException);
+
+        auto stats = dbHelper.getOpenStats();
+        EXPECT_EQ(dbHelper.creates, 1);
+        EXPECT_TRUE(stats.migrated);
+        EXPECT_GT(stats.readyTime, 0);
+        EXPECT_GE(stats.readyTime, stats.openTime + stats.migrateTime + stats.prepareTime);
+
+        // an up to date database only reads the version
+        dbHelper.close();
+        dbHelper.getWriteableDatabase();
+        EXPECT_EQ(dbHelper.creates, 1);
+        EXPECT_FALSE(dbHelper.getOpenStats().migrated);
+        dbHelper.close();
+    }
+
+    {
+        // a failed upgrade rolls back with the version
+        FastStartHelper dbHelper(2, true);
+        EXPECT_THROW(dbHelper.getWriteableDatabase(), sqlite::SQLiteDatabaseException);
+        EXPECT_EQ(dbHelper.upgrades, 1);
+        EXPECT_THROW(dbHelper.getStatement("count_cars"), sqlite::SQLiteDatabaseException);
+        EXPECT_EQ(dbHelper.upgrades, 2);
+        dbHelper.close();
+
+        sqlite::SQLiteDatabase db;
+        db.open("fast_start.db", SQLITE_OPEN_READONLY);
+        EXPECT_EQ(db.getVersion(), 1);
+        EXPECT_THROW(db.query("SELECT make FROM cars"), sqlite::SQLiteDatabaseException);
+        db.close();
+    }
+
+    {
+        FastStartHelper dbHelper(2);
+        auto& db = dbHelper.getWriteableDatabase();
+        EXPECT_EQ(dbHelper.upgrades, 1);
+        EXPECT_EQ(db.getVersion(), 2);
+        EXPECT_NO_THROW(db.query("SELECT make FROM cars"));
+        dbHelper.close();
+    }
+
+    remove("fast_start.db");
+}
+
+// Helper whose first onCreate fails
+class FailingCreateHelper : public sqlite::SQLiteOpenHelper {
+public:
+    FailingCreateHelper() : sqlite::SQLiteOpenHelper("failing_create", 1), creates(0) {}
+
+    virtual void onCreate(sqlite::SQLiteDatabase& db) {
+        if (creates++ == 0) {
+            throw sqlite::SQLiteDatabaseException("create failed");
+        }
+        db.execQuery("CREATE TABLE cars (mpg integer, weight integer)");
+    }
+
+    virtual void onUpgrade(sqlite::SQLiteDatabase&) {}
+
+    int creates;
+};
+
+TEST(SQLiteDatabaseHelper, connection_pool_failed_create_test) {
+
+    remove("failing_create.db");
+
+    {
+        FailingCreateHelper dbHelper;
+
+        // a failed migration closes the pool, the next lease migrates again
+        EXPECT_THROW(dbHelper.acquireWriteableDatabase(), sqlite::SQLiteDatabaseException);
+
+        auto writer = dbHelper.acquireWriteableDatabase();
+        EXPECT_EQ(dbHelper.creates, 2);
+        EXPECT_EQ(writer->getVersion(), 1);
+        EXPECT_NO_THROW(writer->query("SELECT * FROM cars"));
+        writer.release();
+
+        dbHelper.close();
+    }
+
+    remove("failing_create.db");
+}